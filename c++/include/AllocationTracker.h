@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+
+// 堆分配统计（插桩版本）
+// 以-DDETECTION_ALLOC_STATS=ON编译时替换全局operator new/delete，按线程计数，
+// 并把每次分配记到当前线程所在的阶段（检测、NMS、跟踪、绘制等），用于定位和消除每帧的临时分配；
+// 未开启时AllocationScope为空操作，只保留进程峰值内存的查询
+class AllocationTracker {
+public:
+    // 分配归属的阶段，不在任何AllocationScope内的分配记入OtherStage
+    enum Stage {
+        OtherStage = 0,
+        CaptureStage,
+        DetectStage,
+        NMSStage,
+        TrackStage,
+        DrawStage,
+        StageCount
+    };
+
+    // 单个阶段的累计统计
+    struct StageStats {
+        unsigned long long allocations = 0;     // 分配次数
+        unsigned long long bytes = 0;           // 分配字节数
+        unsigned long long deallocations = 0;   // 释放次数
+    };
+
+    // 是否编译了operator new/delete钩子
+    static constexpr bool isEnabled() {
+#if defined(DETECTION_ALLOC_STATS)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // 清零所有线程的计数（在预热之后、主循环之前调用，排除模型加载等一次性分配）
+    static void reset();
+
+    // 获取某阶段所有线程的累计统计
+    static StageStats getStageStats(Stage stage);
+
+    // 获取阶段名称
+    static const char* getStageName(Stage stage);
+
+    // 获取进程的峰值常驻内存（字节），无法获取时返回0
+    static size_t getPeakResidentBytes();
+
+    // 打印各阶段的每帧分配次数和字节数，以及峰值常驻内存
+    static void printStatistics(long long frames);
+
+    // 设置当前线程所在的阶段，返回之前的阶段（供AllocationScope使用）
+    static Stage enterStage(Stage stage);
+};
+
+// 作用域阶段：构造时把当前线程的分配归到stage，析构时恢复之前的阶段
+class AllocationScope {
+public:
+#if defined(DETECTION_ALLOC_STATS)
+    explicit AllocationScope(AllocationTracker::Stage stage)
+        : previous_(AllocationTracker::enterStage(stage)) {}
+
+    ~AllocationScope() {
+        AllocationTracker::enterStage(previous_);
+    }
+#else
+    explicit AllocationScope(AllocationTracker::Stage) {}
+#endif
+
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+
+#if defined(DETECTION_ALLOC_STATS)
+private:
+    AllocationTracker::Stage previous_;         // 进入作用域前的阶段
+#endif
+};
@@ -26,6 +26,105 @@ public:
     // 设置NMS阈值
     void setNMSThreshold(float threshold);
     
+    // 设置推理请求数量
+    void setNumInferRequests(int count);
+    
+    // 设置是否使用图内预处理
+    void setUseModelPreprocess(bool enable);
+    
+    // 设置OpenVINO性能模式
+    void setPerformanceMode(const std::string& mode);
+    
+    // 设置最大批大小
+    void setBatchSize(int size);
+    
+    // 设置编译模型缓存目录
+    void setCacheDir(const std::string& dir);
+    
+    // 设置预热次数
+    void setWarmupIterations(int iterations);
+    
+    // 设置推理精度
+    void setInferencePrecision(const std::string& precision);
+    
+    // 设置INT8量化模型路径
+    void setInt8ModelPath(const std::string& path);
+    
+    // 设置是否启用跟踪引导的ROI检测
+    void setRoiMode(bool enable);
+    
+    // 设置ROI模式下全图检测的间隔帧数
+    void setRoiFullFrameInterval(int interval);
+    
+    // 设置ROI扩展比例
+    void setRoiMargin(float margin);
+    
+    // 设置NMS方式
+    void setNMSMode(const std::string& mode);
+    
+    // 设置NMS时是否合并被抑制目标的关键点
+    void setNMSMergeLandmarks(bool enable);
+    
+    // 设置是否启用多线程流水线
+    void setThreadedPipeline(bool enable);
+    
+    // 设置流水线阶段间队列容量
+    void setPipelineQueueSize(int size);
+    
+    // 设置采集方式
+    void setCaptureMode(const std::string& mode);
+    
+    // 设置是否无界面运行
+    void setHeadless(bool enable);
+    
+    // 设置结构化结果输出文件路径
+    void setResultOutputPath(const std::string& path);
+    
+    // 设置图像缓冲池容量
+    void setFramePoolSize(int size);
+    
+    // 设置OpenVINO推理线程数
+    void setInferenceNumThreads(int threads);
+    
+    // 设置OpenVINO推理流数量
+    void setNumStreams(int streams);
+    
+    // 设置OpenVINO推理线程绑核
+    void setCpuPinning(int mode);
+    
+    // 设置OpenVINO是否使用超线程
+    void setHyperThreading(int mode);
+    
+    // 设置OpenCV线程池线程数
+    void setOpenCVThreads(int threads);
+    
+    // 设置采集线程核心列表
+    void setCaptureCores(const std::string& cores);
+    
+    // 设置检测线程核心列表
+    void setInferCores(const std::string& cores);
+    
+    // 设置跟踪线程核心列表
+    void setTrackCores(const std::string& cores);
+    
+    // 设置主线程核心列表
+    void setOutputCores(const std::string& cores);
+    
+    // 设置追踪事件输出文件路径
+    void setTraceOutputPath(const std::string& path);
+    
+    // 设置是否开启OpenVINO逐层性能计数
+    void setEnableProfiling(bool enable);
+    
+    // 设置逐层耗时表打印的层数
+    void setProfilingTopN(int count);
+    
+    // 设置逐层耗时CSV输出路径
+    void setProfilingCsvPath(const std::string& path);
+    
+    // 设置每帧预算
+    void setFrameDeadlineMs(double deadline);
+    
     // 获取模型路径
     std::string getModelPath() const;
     
@@ -44,6 +143,108 @@ public:
     // 获取NMS阈值
     float getNMSThreshold() const;
     
+    // 获取推理请求数量
+    int getNumInferRequests() const;
+    
+    // 获取是否使用图内预处理
+    bool getUseModelPreprocess() const;
+    
+    // 获取OpenVINO性能模式
+    std::string getPerformanceMode() const;
+    
+    // 获取最大批大小
+    int getBatchSize() const;
+    
+    // 获取编译模型缓存目录
+    std::string getCacheDir() const;
+    
+    // 获取预热次数
+    int getWarmupIterations() const;
+    
+    // 获取推理精度
+    std::string getInferencePrecision() const;
+    
+    // 获取INT8量化模型路径
+    std::string getInt8ModelPath() const;
+    
+    // 获取指定精度实际加载的模型路径（INT8使用量化IR，其余使用原始模型）
+    std::string getModelPathForPrecision(const std::string& precision) const;
+    
+    // 获取是否启用跟踪引导的ROI检测
+    bool getRoiMode() const;
+    
+    // 获取ROI模式下全图检测的间隔帧数
+    int getRoiFullFrameInterval() const;
+    
+    // 获取ROI扩展比例
+    float getRoiMargin() const;
+    
+    // 获取NMS方式
+    std::string getNMSMode() const;
+    
+    // 获取NMS时是否合并被抑制目标的关键点
+    bool getNMSMergeLandmarks() const;
+    
+    // 获取是否启用多线程流水线
+    bool getThreadedPipeline() const;
+    
+    // 获取流水线阶段间队列容量
+    int getPipelineQueueSize() const;
+    
+    // 获取采集方式
+    std::string getCaptureMode() const;
+    
+    // 获取是否无界面运行
+    bool getHeadless() const;
+    
+    // 获取结构化结果输出文件路径
+    std::string getResultOutputPath() const;
+    
+    // 获取图像缓冲池容量
+    int getFramePoolSize() const;
+    
+    // 获取OpenVINO推理线程数
+    int getInferenceNumThreads() const;
+    
+    // 获取OpenVINO推理流数量
+    int getNumStreams() const;
+    
+    // 获取OpenVINO推理线程绑核
+    int getCpuPinning() const;
+    
+    // 获取OpenVINO是否使用超线程
+    int getHyperThreading() const;
+    
+    // 获取OpenCV线程池线程数
+    int getOpenCVThreads() const;
+    
+    // 获取采集线程核心列表
+    std::string getCaptureCores() const;
+    
+    // 获取检测线程核心列表
+    std::string getInferCores() const;
+    
+    // 获取跟踪线程核心列表
+    std::string getTrackCores() const;
+    
+    // 获取主线程核心列表
+    std::string getOutputCores() const;
+    
+    // 获取追踪事件输出文件路径
+    std::string getTraceOutputPath() const;
+    
+    // 获取是否开启OpenVINO逐层性能计数
+    bool getEnableProfiling() const;
+    
+    // 获取逐层耗时表打印的层数
+    int getProfilingTopN() const;
+    
+    // 获取逐层耗时CSV输出路径
+    std::string getProfilingCsvPath() const;
+    
+    // 获取每帧预算
+    double getFrameDeadlineMs() const;
+    
     // 从文件加载配置
     bool loadFromFile(const std::string& filename);
     
@@ -60,4 +261,37 @@ private:
     int detectColor_;                 // 检测颜色：0=红色，1=蓝色
     float confidenceThreshold_;       // 置信度阈值
     float nmsThreshold_;              // NMS阈值
+    int numInferRequests_;            // 推理请求数量（>1时启用异步流水线）
+    bool useModelPreprocess_;         // 是否使用OpenVINO图内预处理
+    std::string performanceMode_;     // OpenVINO性能模式：LATENCY（默认）/THROUGHPUT，空则使用设备默认
+    int batchSize_;                   // 单次推理的最大帧数
+    std::string cacheDir_;            // 编译模型缓存目录（空则不缓存）
+    int warmupIterations_;            // 启动后的预热推理次数
+    std::string inferencePrecision_;  // 推理精度：FP32/BF16/FP16/INT8，空则使用设备默认
+    std::string int8ModelPath_;       // INT8训练后量化模型（IR）路径
+    bool roiMode_;                    // 是否启用跟踪引导的ROI检测
+    int roiFullFrameInterval_;        // ROI模式下全图检测的间隔帧数
+    float roiMargin_;                 // ROI扩展比例（目标框每边扩展宽高的倍数）
+    std::string nmsMode_;             // NMS方式：QUAD=四边形IoU，BOX=轴对齐边界框
+    bool nmsMergeLandmarks_;          // NMS时是否按置信度加权合并关键点
+    bool threadedPipeline_;           // 是否启用采集/检测/跟踪/显示多线程流水线
+    int pipelineQueueSize_;           // 流水线阶段间队列容量
+    std::string captureMode_;         // 采集方式：SEQUENTIAL=逐帧读取，LATEST=只处理最新帧
+    bool headless_;                   // 是否无界面运行（不绘制、不显示）
+    std::string resultOutputPath_;    // 结构化结果（JSON Lines）输出路径，空则不输出
+    int framePoolSize_;               // 图像缓冲池最多保留的空闲缓冲区数，0=不启用
+    int inferenceNumThreads_;         // OpenVINO推理线程数，0=设备默认
+    int numStreams_;                  // OpenVINO推理流数量，0=设备默认，-1=AUTO
+    int cpuPinning_;                  // OpenVINO推理线程绑核：-1=设备默认，0=关闭，1=开启
+    int hyperThreading_;              // OpenVINO是否使用超线程：-1=设备默认，0=否，1=是
+    int opencvThreads_;               // OpenCV线程池线程数，-1=OpenCV默认
+    std::string captureCores_;        // 采集线程核心列表（如"0,1"或"2-3"），空则不绑定
+    std::string inferCores_;          // 检测线程（预处理、后处理、NMS）核心列表
+    std::string trackCores_;          // 跟踪线程核心列表
+    std::string outputCores_;         // 主线程（显示、结果输出；单线程模式下为整个处理循环）核心列表
+    std::string traceOutputPath_;     // 追踪事件（Chrome trace JSON）输出路径，空则不记录
+    bool enableProfiling_;            // 是否开启OpenVINO逐层性能计数
+    int profilingTopN_;               // 逐层耗时表打印耗时最高的层数
+    std::string profilingCsvPath_;    // 逐层耗时CSV输出路径，空则不输出
+    double frameDeadlineMs_;          // 每帧预算（毫秒，采集到出结果），0=不统计
 }; 
\ No newline at end of file
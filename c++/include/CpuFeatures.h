@@ -0,0 +1,20 @@
+#pragma once
+
+// CPU指令集检测
+// AVX2内核只在单个函数上启用指令集（GCC/Clang用target属性，MSVC无需编译选项即可使用内部函数），
+// 调用前用hasAVX2()在运行时确认CPU支持，不支持AVX2的CPU退回SSE2/标量实现，不会因非法指令崩溃
+#if defined(DETECTION_ENABLE_AVX2) && \
+    (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#define DETECTION_HAS_AVX2_KERNELS
+#if defined(_MSC_VER) && !defined(__clang__)
+#define DETECTION_TARGET_AVX2
+#else
+#define DETECTION_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#endif
+#endif
+
+class CpuFeatures {
+public:
+    // CPU和操作系统是否支持AVX2和FMA（首次调用时检测并缓存结果）
+    static bool hasAVX2();
+};
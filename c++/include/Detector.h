@@ -2,8 +2,13 @@
 
 #include <opencv2/opencv.hpp>
 #include <openvino/openvino.hpp>
+#include <array>
+#include <chrono>
+#include <string>
+#include <unordered_map>
 #include <vector>
 #include <memory>
+#include "FusedPreprocessor.h"
 
 // 检测结果结构体
 struct DetectionResult {
@@ -11,35 +16,174 @@ struct DetectionResult {
     float confidence;                               // 置信度
     int classId;                                    // 类别ID
     int colorId;                                    // 颜色ID
-    std::vector<cv::Point2f> landmarks;             // 关键点坐标
+    std::array<cv::Point2f, 4> landmarks;           // 关键点坐标（定长，避免逐个结果的堆分配）
+};
+
+// 检测器选项
+struct DetectorOptions {
+    int numInferRequests = 1;                       // 推理请求数量（>1时启用异步流水线，<=0时取设备推荐值）
+    std::string performanceMode;                    // 性能模式：LATENCY/THROUGHPUT/CUMULATIVE_THROUGHPUT，空则使用设备默认
+    bool useModelPreprocess = false;                // 使用OpenVINO图内预处理（u8 BGR帧直接输入）
+    float confidenceThreshold = 0.45f;              // 置信度阈值
+    int batchSize = 1;                              // 单次推理的最大帧数（>1时输入N维为动态范围[1, batchSize]）
+    std::string cacheDir;                           // 编译模型缓存目录，空则不缓存
+    std::string inferencePrecision;                 // 推理精度：FP32/BF16/FP16，INT8表示加载的是量化模型，空则使用设备默认
+    int inferenceNumThreads = 0;                    // 推理线程数，0=设备默认
+    int numStreams = 0;                             // 推理流数量，0=设备默认，<0=AUTO
+    int cpuPinning = -1;                            // 推理线程绑核（仅CPU）：-1=设备默认，0=关闭，1=开启
+    int hyperThreading = -1;                        // 是否使用超线程（仅CPU）：-1=设备默认，0=否，1=是
+    bool enableProfiling = false;                   // 编译时开启逐层性能计数，每次推理后累计各层耗时
+};
+
+// 单帧检测各阶段耗时（毫秒）
+struct DetectorTiming {
+    double preprocessMs = 0.0;                      // 预处理（写入输入张量）
+    double inferMs = 0.0;                           // 等待推理完成（异步流水线下只包含未被重叠的部分）
+    double postprocessMs = 0.0;                     // 后处理（候选筛选和解码）
+};
+
+// 单个网络层（编译后的执行节点）的累计耗时
+struct LayerProfile {
+    std::string name;                               // 节点名称
+    std::string nodeType;                           // 原始算子类型
+    std::string execType;                           // 实际执行的内核类型（可看出精度，如jit_avx2_FP32）
+    long long count = 0;                            // 执行次数
+    double realTimeMs = 0.0;                        // 累计墙钟耗时（毫秒）
+    double cpuTimeMs = 0.0;                         // 累计CPU耗时（毫秒）
+};
+
+// 流水线输出的单帧结果
+struct FrameResult {
+    long long frameIndex = -1;                      // 帧序号（按提交顺序递增）
+    cv::Mat frame;                                  // 对应的原始帧
+    std::chrono::steady_clock::time_point captureTime;  // 提交时传入的采集时间，随帧经过流水线
+    std::vector<DetectionResult> detections;        // 检测结果（可跨帧复用以避免重复分配）
 };
 
 // 检测器类
 class Detector {
 public:
     Detector(const std::string& modelPath, const std::string& device = "CPU");
+    Detector(const std::string& modelPath, const std::string& device, const DetectorOptions& options);
     ~Detector() = default;
 
     // 执行检测
     std::vector<DetectionResult> detect(const cv::Mat& frame, int detectColor = 1);
     
+    // 执行检测，结果写入调用方复用的容器（稳态下不产生堆分配）
+    // 同步检测借用一个空闲推理请求，不占用帧序号；所有请求都在推理中时抛出异常
+    void detect(const cv::Mat& frame, std::vector<DetectionResult>& results, int detectColor = 1);
+    
+    // 异步流水线检测：提交当前帧，流水线填满后返回最早提交帧的结果
+    // captureTime随帧保存，在结果中原样返回，用于统计采集到出结果的延迟
+    bool detectPipelined(const cv::Mat& frame, int detectColor, FrameResult& result,
+                         std::chrono::steady_clock::time_point captureTime = std::chrono::steady_clock::time_point());
+    
+    // 取出流水线中最早一帧的结果，流水线为空时返回false
+    bool flushPipeline(FrameResult& result);
+    
+    // 将帧提交到空闲推理请求并立即返回帧序号，结果按提交顺序由flushPipeline取出
+    // 调用方自行决定何时取结果（如多路视频流共享推理请求），无空闲请求时抛出异常
+    long long submit(const cv::Mat& frame, int detectColor,
+                     std::chrono::steady_clock::time_point captureTime = std::chrono::steady_clock::time_point());
+    
+    // 是否有空闲推理请求可供submit
+    bool canSubmit() const;
+    
+    // 获取正在推理的帧数
+    int getPendingCount() const;
+    
+    // 批量检测：多帧（如多路相机）合并为一次推理，results[i]对应frames[i]
+    // 帧数超过batchSize时分多次推理；图内预处理模式下同一批的帧尺寸必须一致
+    // 与同步检测一样借用空闲推理请求，所有请求都在推理中时抛出异常
+    void detectBatch(const std::vector<cv::Mat>& frames, 
+                     std::vector<std::vector<DetectionResult>>& results,
+                     int detectColor = 1);
+    
     // 获取模型输入尺寸
     cv::Size getInputSize() const;
+    
+    // 获取流水线深度（推理请求数量）
+    int getPipelineDepth() const;
+    
+    // 获取最大批大小
+    int getBatchSize() const;
+    
+    // 预热：每个推理请求用空白帧执行iterations次完整检测，返回耗时（毫秒），须在提交帧之前调用
+    double warmup(int iterations, const cv::Size& frameSize);
+    
+    // 获取模型加载（读取+编译）耗时（毫秒）
+    double getLoadTime() const;
+    
+    // 获取预热耗时（毫秒）
+    double getWarmupTime() const;
+    
+    // 获取最近一次完成的检测（detect/flushPipeline）的各阶段耗时
+    const DetectorTiming& getLastTiming() const;
+    
+    // 是否开启了逐层性能计数
+    bool isProfilingEnabled() const;
+    
+    // 获取预热之后累计的逐层耗时（按首次出现的顺序，即执行顺序）
+    const std::vector<LayerProfile>& getLayerProfiles() const;
+    
+    // 清空累计的逐层耗时
+    void resetLayerProfiles();
 
 private:
+    // 推理槽：推理请求及其常驻的输入输出张量
+    struct InferSlot {
+        ov::InferRequest request;                   // 推理请求
+        ov::Tensor inputTensor;                     // 常驻输入张量
+        ov::Tensor outputTensor;                    // 常驻输出张量
+        cv::Size inputFrameSize;                    // 图内预处理模式下输入张量对应的帧尺寸
+        int batchCount = 0;                         // 输入输出张量当前的N维大小
+        cv::Mat frame;                              // 正在推理的原始帧
+        int detectColor = 1;                        // 检测颜色
+        long long frameIndex = -1;                  // 帧序号
+        double preprocessMs = 0.0;                  // 该帧的预处理耗时
+        std::chrono::steady_clock::time_point captureTime;  // 该帧的采集时间
+    };
+
     // 初始化模型
     void initializeModel(const std::string& modelPath, const std::string& device);
     
-    // 预处理图像
-    std::vector<float> preprocessImage(const cv::Mat& frame);
+    // 构造编译选项
+    ov::AnyMap buildCompileConfig() const;
+    
+    // 创建推理槽并分配常驻张量
+    void initializeSlot(InferSlot& slot);
+    
+    // 预处理并异步启动一个推理槽，frameIndex为流水线帧序号（同步检测和预热为-1）
+    void startSlot(InferSlot& slot, const cv::Mat& frame, int detectColor, long long frameIndex);
+    
+    // 取得下一个空闲槽供同步检测或批量检测使用，所有槽都在推理中时抛出异常
+    InferSlot& acquireIdleSlot();
+    
+    // 等待推理槽完成并将结果写入results
+    void finishSlot(InferSlot& slot, std::vector<DetectionResult>& results);
+    
+    // 调整推理槽张量的批大小和帧尺寸（仅在变化时调整，容量足够时不重新分配）
+    void resizeSlot(InferSlot& slot, int batchCount, const cv::Size& frameSize);
+    
+    // 将帧写入推理槽输入张量的第batchIndex个位置
+    void prepareInput(InferSlot& slot, const cv::Mat& frame, int batchIndex);
+    
+    // 预处理图像，直接写入NCHW格式的输入缓冲区
+    void preprocessImage(const cv::Mat& frame, float* inputData);
+    
+    // 在logit空间筛选置信度达标的行，返回候选行数量（结果写入candidateRows_）
+    int selectCandidates(const float* outputData);
+    
+    // 累计推理请求最近一次推理的逐层耗时（仅开启性能计数时）
+    void accumulateLayerProfiles(const ov::InferRequest& request);
     
     // 后处理检测结果
-    std::vector<DetectionResult> postprocessResults(const float* outputData, 
-                                                   const std::vector<int>& outputShape,
-                                                   int detectColor);
+    void postprocessResults(const float* outputData, int detectColor,
+                            std::vector<DetectionResult>& results);
     
     // 计算边界框
-    cv::Rect computeBoundingBox(const std::vector<cv::Point2f>& points);
+    cv::Rect computeBoundingBox(const std::array<cv::Point2f, 4>& points);
     
     // Sigmoid激活函数
     inline float sigmoid(float x) const {
@@ -49,8 +193,24 @@ private:
 private:
     ov::Core core_;                                 // OpenVINO核心对象
     ov::CompiledModel compiledModel_;               // 编译后的模型
-    ov::InferRequest inferRequest_;                 // 推理请求
     ov::Output<const ov::Node> inputPort_;          // 输入端口
     ov::Output<const ov::Node> outputPort_;         // 输出端口
     cv::Size inputSize_;                            // 模型输入尺寸
+    int numBoxes_ = 0;                              // 输出检测框数量
+    int numAttrs_ = 0;                              // 每个检测框的属性数量
+    float logitThreshold_ = 0.0f;                   // 置信度阈值对应的logit（sigmoid的反函数）
+    std::vector<int> candidateRows_;                // 通过置信度预筛选的行索引
+    
+    DetectorOptions options_;                       // 检测器选项
+    std::vector<InferSlot> slots_;                  // 流水线推理槽（环形缓冲区）
+    size_t nextSlot_ = 0;                           // 下一个空闲槽的位置
+    size_t pendingCount_ = 0;                       // 正在推理的槽数量
+    long long submittedFrames_ = 0;                 // 已提交的帧数
+    double loadTimeMs_ = 0.0;                       // 模型加载耗时（毫秒）
+    double warmupTimeMs_ = 0.0;                     // 预热耗时（毫秒）
+    DetectorTiming lastTiming_;                     // 最近一次完成的检测的各阶段耗时
+    std::vector<LayerProfile> layerProfiles_;       // 逐层累计耗时
+    std::unordered_map<std::string, size_t> layerIndex_;  // 节点名称到layerProfiles_下标
+    
+    FusedPreprocessor fusedPreprocessor_;           // 单次遍历的融合预处理器
 }; 
\ No newline at end of file
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Detector.h"
+#include "PerformanceMonitor.h"
+#include "SPSCQueue.h"
+
+// 前向声明
+class STrack;
+
+// 在流水线各阶段之间传递的帧数据
+struct FramePacket {
+    long long sequence = -1;                                    // 帧序号（采集顺序）
+    std::chrono::steady_clock::time_point captureTime;          // 采集完成时间戳
+    cv::Mat frame;                                              // 原始图像
+    std::vector<DetectionResult> detections;                    // 检测结果（原始图像坐标，已NMS）
+    std::vector<STrack> tracks;                                 // 跟踪结果
+    double inferenceTime = 0.0;                                 // 检测阶段耗时（毫秒）
+    PerformanceMonitor::FrameStageTimes stageTimes{};           // 各处理阶段耗时（毫秒，用于截止时间归因）
+    bool endOfStream = false;                                   // 输入结束标记
+};
+
+// 单个阶段的统计信息
+struct PipelineStageStats {
+    std::string name;                                           // 阶段名称
+    long long processedFrames = 0;                              // 已处理帧数
+    double busyMs = 0.0;                                        // 处理耗时累计（毫秒）
+    double inputWaitMs = 0.0;                                   // 等待上游数据的时间累计（毫秒）
+    double outputStallMs = 0.0;                                 // 下游队列已满而阻塞的时间累计（毫秒）
+    size_t queueDepth = 0;                                      // 输出队列当前深度
+    size_t maxQueueDepth = 0;                                   // 输出队列最大深度
+    size_t queueCapacity = 0;                                   // 输出队列容量
+    long long droppedFrames = 0;                                // 只处理最新帧时跳过的帧数
+};
+
+// 多线程帧处理流水线
+// 采集 -> 检测 -> 跟踪 -> 显示，前三个阶段各占一个线程，显示在调用run的线程上执行（HighGUI要求）；
+// 相邻阶段之间用有界SPSC队列连接，吞吐由最慢的阶段决定，而不是各阶段耗时之和
+class FramePipeline {
+public:
+    using CaptureFunc = std::function<bool(FramePacket&)>;     // 读取一帧到packet.frame（可填写采集时间戳），返回false表示输入结束
+    using StageFunc = std::function<void(FramePacket&)>;       // 处理一帧
+    using DisplayFunc = std::function<bool(FramePacket&)>;     // 显示一帧，返回false请求停止
+
+    explicit FramePipeline(size_t queueCapacity = 4);
+    ~FramePipeline();
+
+    // 设置各阶段的处理函数（需在run之前调用）
+    void setCaptureStage(CaptureFunc capture);
+    void setInferStage(StageFunc infer);
+    void setTrackStage(StageFunc track);
+
+    // 检测阶段只处理输入队列中最新的一帧，其余计为丢帧（实时瞄准时旧帧不如不处理）
+    void setLatestOnly(bool enable);
+
+    // 设置各阶段线程绑定的核心（需在run之前调用），列表为空的阶段不绑定
+    // 显示阶段的核心在run中启动工作线程之后应用到调用线程
+    void setStageCores(const std::vector<int>& captureCores, const std::vector<int>& inferCores,
+                       const std::vector<int>& trackCores, const std::vector<int>& displayCores);
+
+    // 启动工作线程并在当前线程执行显示阶段，直到输入结束或display返回false
+    // 工作线程中的异常会在此处重新抛出
+    void run(const DisplayFunc& display);
+
+    // 请求停止并等待工作线程退出
+    void stop();
+
+    // 获取各阶段统计信息（可在运行中调用）
+    std::vector<PipelineStageStats> getStageStats() const;
+
+    // 打印各阶段统计信息
+    void printStatistics() const;
+
+private:
+    // 阶段计数器（由阶段线程写入，其他线程读取）
+    struct StageCounters {
+        std::atomic<long long> processedFrames{0};
+        std::atomic<long long> busyNs{0};
+        std::atomic<long long> inputWaitNs{0};
+        std::atomic<long long> outputStallNs{0};
+        std::atomic<size_t> maxQueueDepth{0};
+        std::atomic<long long> droppedFrames{0};
+    };
+
+    using PacketQueue = SPSCQueue<FramePacket>;
+
+    enum Stage { CaptureStage = 0, InferStage, TrackStage, DisplayStage, StageCount };
+
+    // 各阶段线程主循环
+    void captureLoop();
+    void workerLoop(Stage stage, PacketQueue& input, PacketQueue& output, const StageFunc& func);
+
+    // 阻塞入队/出队，停止时返回false；等待时间计入对应阶段
+    bool pushPacket(PacketQueue& queue, FramePacket& packet, StageCounters& counters);
+    bool popPacket(PacketQueue& queue, FramePacket& packet, StageCounters& counters);
+
+    // 记录工作线程异常并请求停止
+    void recordError();
+
+    // 将当前线程绑定到该阶段的核心，并以阶段名称命名追踪视图中的线程
+    void setupStageThread(Stage stage);
+
+private:
+    PacketQueue captureQueue_;                  // 采集 -> 检测
+    PacketQueue inferQueue_;                    // 检测 -> 跟踪
+    PacketQueue trackQueue_;                    // 跟踪 -> 显示
+
+    CaptureFunc capture_;                       // 采集函数
+    StageFunc infer_;                           // 检测函数
+    StageFunc track_;                           // 跟踪函数
+
+    StageCounters counters_[StageCount];        // 各阶段计数器
+    std::vector<std::thread> threads_;          // 工作线程
+    std::atomic<bool> stopRequested_{false};    // 停止标志
+    bool latestOnly_ = false;                   // 检测阶段是否只处理最新帧
+    std::vector<int> stageCores_[StageCount];   // 各阶段线程绑定的核心
+
+    std::mutex errorMutex_;                     // 保护error_
+    std::exception_ptr error_;                  // 工作线程中的第一个异常
+};
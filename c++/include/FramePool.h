@@ -0,0 +1,55 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// 图像缓冲池
+// 作为cv::Mat的分配器使用：挂到池上的Mat在create时从池中取缓冲区，
+// 最后一个引用（可能在任意流水线阶段、任意线程）释放时缓冲区回到池中而不是交还系统。
+// 引用计数沿用cv::Mat自身的机制，帧同时在多个阶段中流转时也只有全部释放后才会被复用。
+// 记录引用计数的UMatData头也一并复用，稳态下取帧和回池都不经过系统分配。
+// 注意：池必须比所有从它分配的Mat活得更久
+class FramePool : public cv::MatAllocator {
+public:
+    // maxCachedBuffers为池中最多保留的空闲缓冲区数，0表示不启用（使用OpenCV默认分配器）
+    explicit FramePool(size_t maxCachedBuffers = 8);
+    ~FramePool() override;
+
+    FramePool(const FramePool&) = delete;
+    FramePool& operator=(const FramePool&) = delete;
+
+    // 释放mat当前内容，并使其后续的create从池中分配（cap.read、copyTo等都会调用create）
+    void attach(cv::Mat& mat);
+
+    // 从池中取一块指定尺寸和类型的图像
+    cv::Mat acquire(const cv::Size& size, int type);
+
+    // 是否启用
+    bool isEnabled() const;
+
+    // 获取新分配的缓冲区数量
+    long long getAllocatedBuffers() const;
+
+    // 获取复用的次数
+    long long getReusedBuffers() const;
+
+    // 打印统计信息
+    void printStatistics() const;
+
+    // cv::MatAllocator接口
+    cv::UMatData* allocate(int dims, const int* sizes, int type, void* data, size_t* step,
+                           cv::AccessFlag flags, cv::UMatUsageFlags usageFlags) const override;
+    bool allocate(cv::UMatData* data, cv::AccessFlag accessFlags, cv::UMatUsageFlags usageFlags) const override;
+    void deallocate(cv::UMatData* data) const override;
+
+private:
+    size_t maxCachedBuffers_;                                       // 最多保留的空闲缓冲区数
+    mutable std::mutex mutex_;                                      // 保护以下成员
+    mutable std::vector<std::pair<size_t, uchar*>> freeBuffers_;    // 空闲缓冲区（字节数，地址）
+    mutable std::vector<void*> freeHeaders_;                        // 已析构、可重新构造的UMatData头的内存
+    mutable long long allocatedBuffers_ = 0;                        // 新分配的缓冲区数量
+    mutable long long reusedBuffers_ = 0;                           // 从池中复用的次数
+    mutable long long outstandingBuffers_ = 0;                      // 仍被Mat引用的缓冲区数量
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+// 融合预处理类
+// 一次遍历完成双线性缩放、BGR转RGB、归一化和HWC转CHW，
+// 代替 resize -> cvtColor -> convertTo -> split -> memcpy 的多次内存遍历
+// 采样表按(源尺寸, 目标尺寸)缓存最近使用的若干组，多路不同分辨率的流和不同尺寸的ROI交替处理时无需每帧重建
+class FusedPreprocessor {
+public:
+    // 一组源/目标尺寸对应的采样表
+    struct SampleTables {
+        cv::Size srcSize;                           // 采样表对应的源尺寸
+        cv::Size dstSize;                           // 采样表对应的目标尺寸
+        std::vector<int> xOffsets0;                 // 每个输出列左采样点在源行内的字节偏移
+        std::vector<int> xOffsets1;                 // 每个输出列右采样点在源行内的字节偏移
+        std::vector<float> xWeights;                // 每个输出列右采样点的权重
+        std::vector<int> yRows0;                    // 每个输出行上采样行号
+        std::vector<int> yRows1;                    // 每个输出行下采样行号
+        std::vector<float> yWeights;                // 每个输出行下采样行的权重
+        int vectorEnd = 0;                          // 可安全使用4字节向量加载的输出列数
+        unsigned long long lastUse = 0;             // 最近一次使用的序号，缓存满时淘汰最久未用的一组
+    };
+
+    FusedPreprocessor() = default;
+    ~FusedPreprocessor() = default;
+
+    // 执行预处理：src为u8 BGR图像，结果按R、G、B三个平面写入output（每个平面dstSize大小）
+    void process(const cv::Mat& src, const cv::Size& dstSize, float* output, float scale = 1.0f / 255.0f);
+
+    // 按给定采样表处理输出行区间[rowBegin, rowEnd)，供并行任务调用
+    static void processRows(const SampleTables& tables, const cv::Mat& src, float* output, float scale,
+                            int rowBegin, int rowEnd);
+
+    // 获取采样表重建次数（命中缓存时不增加）
+    long long getTableBuilds() const;
+
+private:
+    // 查找源/目标尺寸对应的采样表，未缓存时构建（缓存满时替换最久未用的一组）
+    const SampleTables& findTables(const cv::Size& srcSize, const cv::Size& dstSize);
+
+    // 构建一组采样表
+    static void buildTables(const cv::Size& srcSize, const cv::Size& dstSize, SampleTables& tables);
+
+private:
+    static constexpr size_t kMaxCachedTables = 8;   // 最多缓存的采样表组数
+
+    std::vector<SampleTables> tables_;              // 已缓存的采样表
+    unsigned long long useCounter_ = 0;             // 使用序号
+    long long tableBuilds_ = 0;                     // 采样表重建次数
+};
\ No newline at end of file
@@ -1,8 +1,13 @@
 #pragma once
 
 #include <opencv2/opencv.hpp>
+#include <string>
 #include <vector>
 #include "Detector.h"
+#include "FusedPreprocessor.h"
+
+// 前向声明
+class STrack;
 
 // 图像处理类
 class ImageProcessor {
@@ -19,12 +24,60 @@ public:
                               float confidenceThreshold = 0.45f,
                               float nmsThreshold = 0.45f);
     
+    // 基于四个关键点围成的凸四边形IoU的NMS，只在类别和颜色相同的检测之间抑制
+    // mergeLandmarks为true时，保留目标的关键点取其与被抑制目标按置信度加权的平均
+    void applyQuadNMS(const std::vector<DetectionResult>& detections,
+                      float confidenceThreshold,
+                      float nmsThreshold,
+                      bool mergeLandmarks,
+                      std::vector<DetectionResult>& output);
+    
+    // 按NMS方式筛选检测结果（与配置项nms_mode一致）：BOX为轴对齐框NMS，其余为四边形NMS
+    // mergeLandmarks只对四边形NMS生效；output不能与detections是同一个容器
+    void applyNMSByMode(const std::vector<DetectionResult>& detections,
+                        float confidenceThreshold,
+                        float nmsThreshold,
+                        const std::string& nmsMode,
+                        bool mergeLandmarks,
+                        std::vector<DetectionResult>& output);
+    
     // 调整检测结果到原始图像尺寸
     std::vector<DetectionResult> scaleResultsToOriginal(const std::vector<DetectionResult>& results,
                                                         const cv::Size& originalSize,
                                                         const cv::Size& processedSize);
+    
+    // 根据跟踪目标下一帧的预测位置生成ROI（尺寸与模型输入一致，1:1像素裁剪）
+    // 目标扩展后超出ROI尺寸或帧小于模型输入时返回false，此时应进行全图检测
+    bool computeTrackROIs(const std::vector<STrack>& tracks,
+                          const cv::Size& frameSize,
+                          const cv::Size& inputSize,
+                          float margin,
+                          std::vector<cv::Rect>& rois);
+    
+    // 将ROI内的检测结果映射回原始帧坐标并追加到output
+    void mapROIResultsToFrame(const std::vector<DetectionResult>& results,
+                              const cv::Rect& roi,
+                              const cv::Size& inputSize,
+                              std::vector<DetectionResult>& output);
 
 private:
     // 将图像转换为模型输入格式
     std::vector<float> convertToTensor(const cv::Mat& image);
+
+private:
+    // 四边形NMS的候选目标（逆时针凸多边形及其外接框）
+    struct QuadCandidate {
+        cv::Point2f vertices[4];            // 凸包顶点
+        int numVertices;                    // 顶点数（退化时为3）
+        float area;                         // 凸包面积
+        float minX, minY, maxX, maxY;       // 外接框，用于快速排除
+    };
+
+private:
+    FusedPreprocessor fusedPreprocessor_;   // 融合预处理器
+    std::vector<int> nmsOrder_;             // 四边形NMS：按置信度降序的候选索引
+    std::vector<QuadCandidate> nmsQuads_;   // 四边形NMS：与nmsOrder_对应的候选几何
+    std::vector<char> nmsSuppressed_;       // 四边形NMS：候选是否已被抑制
+    std::vector<cv::Rect> nmsBoxes_;        // 框NMS：候选外接框
+    std::vector<float> nmsConfidences_;     // 框NMS：候选置信度
 }; 
\ No newline at end of file
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// 耗时直方图（HDR风格的对数-线性分桶）
+// 以微秒记录，64微秒以下每桶1微秒，其上每个2的幂区间分为32个桶，相对误差不超过1/32；
+// 桶数组大小固定，记录只做几次relaxed原子操作，不加锁、不分配内存，可在多个线程中同时记录
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+
+    // 记录一次耗时（毫秒），超出上限的值不进入任何桶，单独计入溢出计数，最大值仍按实际值记录
+    void record(double milliseconds);
+
+    // 获取记录次数（含溢出）
+    long long getCount() const;
+
+    // 获取超出分桶上限的记录次数
+    long long getOverflowCount() const;
+
+    // 获取平均值（毫秒）
+    double getMean() const;
+
+    // 获取最小值（毫秒）
+    double getMin() const;
+
+    // 获取最大值（毫秒）
+    double getMax() const;
+
+    // 获取百分位数（毫秒，percentile取0~100），返回所在桶的上界，不超过最大值；落在溢出部分时返回最大值
+    double getPercentile(double percentile) const;
+
+    // 分桶上限（毫秒），不小于该值的记录计为溢出
+    static double getRangeMax();
+
+    // 清空（不应与record并发调用）
+    void reset();
+
+private:
+    // 微秒值对应的桶序号，超出上限时返回-1
+    static int bucketIndex(uint64_t micros);
+
+    // 桶序号对应的上界（微秒）
+    static uint64_t bucketUpperBound(int index);
+
+private:
+    static constexpr int kSubBucketBits = 5;                        // 每个2的幂区间的桶数为2^5
+    static constexpr int kSubBucketCount = 1 << kSubBucketBits;     // 32
+    static constexpr int kMaxShift = 26;                            // 上限约2^(26+6)微秒，远超任何单帧耗时
+    static constexpr int kBucketCount = (kMaxShift + 2) * kSubBucketCount;
+
+    std::atomic<uint64_t> buckets_[kBucketCount];                   // 各桶计数
+    std::atomic<uint64_t> overflow_;                                // 超出分桶上限的记录次数
+    std::atomic<uint64_t> count_;                                   // 记录次数
+    std::atomic<uint64_t> sumMicros_;                               // 耗时之和（微秒）
+    std::atomic<uint64_t> minMicros_;                               // 最小值（微秒）
+    std::atomic<uint64_t> maxMicros_;                               // 最大值（微秒）
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class FramePool;
+
+// 最新帧采集类
+// 后台线程持续从VideoCapture读取帧并覆盖单帧邮箱，消费者每次只取最新的一帧；
+// 未被取走就被覆盖的帧计为丢帧。推理暂时变慢时丢弃旧帧而不是排队，延迟不会累积
+class LatestFrameGrabber {
+public:
+    // paceFps > 0 时按该帧率节流读取（用录像模拟相机），否则尽快读取
+    // framePool非空时采集帧从缓冲池分配
+    explicit LatestFrameGrabber(cv::VideoCapture& capture, double paceFps = 0.0, FramePool* framePool = nullptr);
+    ~LatestFrameGrabber();
+
+    // 设置采集线程绑定的核心（需在start之前调用），为空则不绑定
+    void setCores(const std::vector<int>& cores);
+
+    // 启动后台采集线程
+    void start();
+
+    // 停止并等待采集线程退出
+    void stop();
+
+    // 取出最新一帧；没有新帧时阻塞等待，输入结束且无剩余帧时返回false
+    // grabTime非空时写入该帧的采集完成时间
+    bool read(cv::Mat& frame, std::chrono::steady_clock::time_point* grabTime = nullptr);
+    
+    // 非阻塞读取：有新帧时取出并返回true，否则立即返回false
+    bool tryRead(cv::Mat& frame, std::chrono::steady_clock::time_point* grabTime = nullptr);
+    
+    // 输入是否已结束且没有剩余帧
+    bool isFinished() const;
+
+    // 获取已采集帧数
+    long long getGrabbedFrames() const;
+
+    // 获取已交付帧数
+    long long getDeliveredFrames() const;
+
+    // 获取丢帧数
+    long long getDroppedFrames() const;
+
+    // 打印采集统计
+    void printStatistics() const;
+
+private:
+    // 采集线程主循环
+    void grabLoop();
+
+private:
+    cv::VideoCapture& capture_;                         // 视频源
+    double paceFps_;                                    // 节流帧率（<=0不节流）
+    FramePool* framePool_;                              // 采集帧缓冲池（可为空）
+    std::vector<int> cores_;                            // 采集线程绑定的核心
+    std::thread thread_;                                // 采集线程
+    std::atomic<bool> stopRequested_{false};            // 停止标志
+
+    mutable std::mutex mutex_;                          // 保护以下成员
+    std::condition_variable frameReady_;                // 新帧或输入结束通知
+    cv::Mat slot_;                                      // 单帧邮箱
+    std::chrono::steady_clock::time_point slotTime_;    // 邮箱中帧的采集时间
+    bool hasFrame_ = false;                             // 邮箱中是否有未取走的帧
+    bool finished_ = false;                             // 输入是否已结束
+    long long grabbedFrames_ = 0;                       // 已采集帧数
+    long long deliveredFrames_ = 0;                     // 已交付帧数
+    long long droppedFrames_ = 0;                       // 被覆盖的帧数
+    std::exception_ptr error_;                          // 采集线程中的异常
+};
@@ -1,12 +1,32 @@
 #pragma once
 
+#include <array>
 #include <chrono>
 #include <string>
 #include <iostream>
+#include <vector>
+#include "LatencyHistogram.h"
+
+// 前向声明
+struct LayerProfile;
+
+// 帧截止时间统计（用于界面实时显示）
+struct DeadlineStats {
+    double deadlineMs = 0.0;                    // 每帧预算（毫秒），<=0表示未启用
+    long long frames = 0;                       // 参与统计的帧数
+    long long misses = 0;                       // 超出预算的帧数
+    long long currentStreak = 0;                // 当前连续超时帧数
+    long long longestStreak = 0;                // 最长连续超时帧数
+    bool lastMissed = false;                    // 最近一帧是否超时
+};
 
 // 性能监控类
 class PerformanceMonitor {
 public:
+    // 分阶段统计耗时分布的阶段
+    enum Stage { DecodeStage = 0, PreprocessStage, InferStage, PostprocessStage, NMSStage,
+                 TrackStage, RenderStage, EndToEndStage, StageCount };
+
     PerformanceMonitor();
     ~PerformanceMonitor() = default;
 
@@ -22,10 +42,59 @@ public:
     // 增加帧数计数
     void incrementFrameCount();
     
-    // 获取总执行时间（秒）
+    // 记录启动耗时（模型读取+编译，毫秒）
+    void recordStartupTime(double startupTime);
+    
+    // 记录预热耗时（毫秒）
+    void recordWarmupTime(double warmupTime);
+    
+    // 记录从程序启动到首个有效检测结果的耗时（毫秒），仅第一次调用生效
+    void recordFirstDetectionTime(double firstDetectionTime);
+    
+    // 记录单帧绘制和显示耗时（毫秒，无界面模式下不调用）
+    void recordRenderTime(double renderTime);
+    
+    // 设置绘制和显示是否与检测并行（多线程流水线），并行时绘制耗时不从墙钟时间中扣除来估算无界面帧率
+    void setRenderOverlapped(bool overlapped);
+    
+    // 记录单帧从采集完成到检测、NMS、跟踪结果输出的延迟（毫秒），同时计入端到端阶段的直方图
+    void recordLatency(double latency);
+    
+    // 记录单帧某阶段的耗时（毫秒），只写入该阶段的直方图，可在任意线程调用
+    void recordStageTime(Stage stage, double stageTime);
+    
+    // 获取某阶段的耗时直方图
+    const LatencyHistogram& getStageHistogram(Stage stage) const;
+    
+    // 获取某阶段耗时的百分位数（毫秒，percentile取0~100）
+    double getStagePercentile(Stage stage, double percentile) const;
+    
+    // 获取阶段名称
+    static const char* getStageName(Stage stage);
+    
+    // 逐帧样本的百分位数（最近秩，percentile取0~100），sorted须已按升序排序，为空时返回0
+    static double percentileOfSorted(const std::vector<double>& sorted, double percentile);
+    
+    // 单帧各阶段耗时（毫秒，按Stage索引，未测量的阶段为0）
+    using FrameStageTimes = std::array<double, StageCount>;
+    
+    // 设置每帧预算（毫秒，如200FPS相机为5），<=0时不统计
+    void setFrameDeadline(double deadline);
+    
+    // 按采集到出结果的延迟判断该帧是否超出预算；超时时归因于比自身中位数超出最多的阶段，
+    // 延迟中不属于预处理、推理、后处理、NMS、跟踪的部分（排队、流水线中的等待）归为wait
+    void recordFrameDeadline(double latency, const FrameStageTimes& stageTimes);
+    
+    // 获取截止时间统计
+    DeadlineStats getDeadlineStats() const;
+    
+    // 获取超时量（延迟减预算）的分布
+    const LatencyHistogram& getOvershootHistogram() const;
+    
+    // 获取总执行时间（秒），计时中返回已经过的时间
     double getTotalTime() const;
     
-    // 获取平均FPS
+    // 获取按推理时间计算的FPS（1000 / 平均推理时间，不是实际吞吐）
     double getAverageFPS() const;
     
     // 获取平均推理时间（毫秒）
@@ -34,9 +103,24 @@ public:
     // 获取总帧数
     int getTotalFrames() const;
     
+    // 获取按墙钟时间计算的FPS（总帧数/总执行时间），即实际吞吐
+    double getWallClockFPS() const;
+    
+    // 获取平均采集到出结果的延迟（毫秒）
+    double getAverageLatency() const;
+    
+    // 获取最大采集到出结果的延迟（毫秒）
+    double getMaxLatency() const;
+    
     // 打印性能统计
     void printStatistics() const;
     
+    // 打印累计耗时最高的topN个网络层（Detector::getLayerProfiles）
+    void printLayerProfiles(const std::vector<LayerProfile>& layers, int topN) const;
+    
+    // 将全部网络层按累计耗时降序写入CSV文件，文件无法创建时返回false
+    bool writeLayerProfilesCsv(const std::vector<LayerProfile>& layers, const std::string& path) const;
+    
     // 重置统计
     void reset();
 
@@ -46,4 +130,21 @@ private:
     int totalFrames_;                                             // 总帧数
     double totalInferenceTime_;                                   // 总推理时间（秒）
     bool isRunning_;                                              // 是否正在计时
+    double startupTime_;                                          // 启动耗时（毫秒）
+    double warmupTime_;                                           // 预热耗时（毫秒）
+    double firstDetectionTime_;                                   // 首个有效检测耗时（毫秒，<0表示尚未记录）
+    double totalRenderTime_;                                      // 绘制和显示总耗时（毫秒）
+    int renderFrames_;                                            // 绘制和显示的帧数
+    bool renderOverlapped_;                                       // 绘制和显示是否与检测并行
+    double totalLatency_;                                         // 采集到出结果的延迟之和（毫秒）
+    double maxLatency_;                                           // 采集到出结果的最大延迟（毫秒）
+    int latencyFrames_;                                           // 记录了延迟的帧数
+    LatencyHistogram stageHistograms_[StageCount];                // 各阶段耗时直方图
+    
+    static constexpr int kWaitCulprit = StageCount;               // 超时归因于等待时的下标
+    DeadlineStats deadlineStats_;                                 // 截止时间统计
+    LatencyHistogram overshootHistogram_;                         // 超时量分布
+    LatencyHistogram waitHistogram_;                              // 每帧等待时间分布（用于归因）
+    long long missesByCulprit_[StageCount + 1];                   // 按归因阶段统计的超时帧数
+    double overshootByCulprit_[StageCount + 1];                   // 按归因阶段累计的超时量（毫秒）
 }; 
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Detector.h"
+
+// 前向声明
+class STrack;
+
+// 结构化结果输出类
+// 每帧输出一行JSON（JSON Lines），供无界面运行时的下游程序或离线分析使用
+class ResultSink {
+public:
+    ResultSink() = default;
+    ~ResultSink();
+
+    // 打开输出文件
+    bool open(const std::string& path);
+
+    // 是否已打开
+    bool isOpen() const;
+
+    // 写入一帧的检测和跟踪结果，latencyMs为该帧采集完成到结果输出的延迟
+    void write(long long frameIndex, double timestampMs, double latencyMs,
+               const std::vector<DetectionResult>& detections,
+               const std::vector<STrack>& tracks);
+
+    // 关闭输出文件
+    void close();
+
+    // 获取已写入帧数
+    long long getWrittenFrames() const;
+
+private:
+    // 按printf格式直接追加到行缓冲区末尾，长度不受限制
+    void append(const char* format, ...);
+
+    // 追加一个数值，NaN/Inf写为null，保证每行都是合法JSON
+    void appendNumber(const char* format, double value);
+
+private:
+    std::ofstream file_;                // 输出文件
+    std::string line_;                  // 复用的行缓冲区
+    long long writtenFrames_ = 0;       // 已写入帧数
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// 有界单生产者/单消费者无锁环形队列
+// 只允许一个线程调用tryPush、另一个线程调用tryPop；
+// 读写位置单调递增，各占一条缓存行，并在本端缓存对端位置以减少跨核同步
+template <typename T>
+class SPSCQueue {
+public:
+    explicit SPSCQueue(size_t capacity)
+        : capacity_(capacity > 0 ? capacity : 1) {
+        size_t slots = 1;
+        while (slots < capacity_) slots <<= 1;
+        buffer_.resize(slots);
+        mask_ = slots - 1;
+    }
+
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+    // 入队（生产者线程）：队列已满时返回false且不移动item
+    bool tryPush(T&& item) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - headCache_ >= capacity_) {
+            headCache_ = head_.load(std::memory_order_acquire);
+            if (tail - headCache_ >= capacity_) return false;
+        }
+        buffer_[tail & mask_] = std::move(item);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 出队（消费者线程）：队列为空时返回false
+    bool tryPop(T& item) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tailCache_) {
+            tailCache_ = tail_.load(std::memory_order_acquire);
+            if (head == tailCache_) return false;
+        }
+        item = std::move(buffer_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 当前元素数量（其他线程读取时为近似值）
+    size_t size() const {
+        const size_t head = head_.load(std::memory_order_acquire);
+        const size_t tail = tail_.load(std::memory_order_acquire);
+        return tail - head;
+    }
+
+    // 队列容量
+    size_t capacity() const { return capacity_; }
+
+private:
+    static constexpr size_t kCacheLine = 64;
+
+    std::vector<T> buffer_;                                 // 环形缓冲区（容量向上取2的幂）
+    size_t capacity_;                                       // 允许的最大元素数量
+    size_t mask_ = 0;                                       // 下标掩码
+
+    alignas(kCacheLine) std::atomic<size_t> head_{0};       // 读位置（消费者写）
+    size_t tailCache_ = 0;                                  // 消费者缓存的写位置
+
+    alignas(kCacheLine) std::atomic<size_t> tail_{0};       // 写位置（生产者写）
+    size_t headCache_ = 0;                                  // 生产者缓存的读位置
+};
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Config.h"
+#include "Detector.h"
+#include "ImageProcessor.h"
+#include "LatestFrameGrabber.h"
+
+// 前向声明
+class BYTETracker;
+class STrack;
+class FramePool;
+
+// 单路视频流的统计
+struct StreamStats {
+    std::string name;                   // 流名称
+    long long processedFrames = 0;      // 已处理帧数
+    long long droppedFrames = 0;        // 采集后未被调度就被覆盖的帧数
+    double fps = 0.0;                   // 处理帧率（按调度运行的墙钟时间计算）
+    double meanLatencyMs = 0.0;         // 平均延迟（采集完成到跟踪完成）
+    double maxLatencyMs = 0.0;          // 最大延迟
+};
+
+// 多路视频流调度类
+// 所有流共享一个检测器（同一个编译模型和推理请求池），每路流有独立的采集线程、
+// BYTETracker以及各自配置中的检测颜色、置信度/NMS阈值和NMS方式。
+// 有空闲推理请求时从上次服务的流之后开始轮转，为下一路有新帧的流提交推理，
+// 任何一路流都不能连续占用推理请求；结果按提交顺序取出，每路流内的帧序不变
+class StreamScheduler {
+public:
+    // 每帧结果回调：流序号、原始帧、检测结果、跟踪结果、延迟（毫秒），返回false时停止调度
+    using ResultCallback = std::function<bool(int streamIndex, const cv::Mat& frame,
+                                              const std::vector<DetectionResult>& detections,
+                                              const std::vector<STrack>& tracks,
+                                              double latencyMs)>;
+
+    // framePool非空时各路采集帧从缓冲池分配
+    explicit StreamScheduler(Detector& detector, FramePool* framePool = nullptr);
+    ~StreamScheduler();
+
+    // 添加一路视频流（打开config中的视频路径），返回流序号，打开失败时抛出异常
+    int addStream(const Config& config, const std::string& name);
+
+    // 获取流数量
+    int getStreamCount() const;
+
+    // 获取指定流的帧尺寸
+    cv::Size getFrameSize(int streamIndex) const;
+
+    // 启动各路采集并调度，直到所有流结束或回调返回false
+    void run(const ResultCallback& onResult);
+
+    // 获取指定流的统计
+    StreamStats getStreamStats(int streamIndex) const;
+
+    // 打印各路流的统计
+    void printStatistics() const;
+
+private:
+    // 单路视频流
+    struct Stream {
+        std::string name;                                   // 流名称
+        Config config;                                      // 该路的检测颜色、阈值等配置
+        cv::VideoCapture capture;                           // 视频源
+        std::unique_ptr<LatestFrameGrabber> grabber;        // 后台采集
+        std::unique_ptr<BYTETracker> tracker;               // 该路独立的跟踪器
+        long long processedFrames = 0;                      // 已处理帧数
+        double latencySumMs = 0.0;                          // 延迟之和
+        double latencyMaxMs = 0.0;                          // 最大延迟
+    };
+
+    // 正在推理的帧（与检测器的提交顺序一致），采集时间随帧保存在检测器中
+    struct InFlightFrame {
+        int streamIndex;                                    // 所属流
+    };
+
+    // 从轮转位置开始找到下一路有新帧的流并提交推理，没有新帧时返回false
+    bool submitNextStream();
+
+    // 取出最早提交帧的结果，完成该路的NMS、跟踪并回调
+    bool completeOldest(const ResultCallback& onResult);
+
+    // 所有流是否都已结束
+    bool allStreamsFinished() const;
+
+private:
+    Detector& detector_;                                    // 共享检测器
+    FramePool* framePool_;                                  // 采集帧缓冲池（可为空）
+    ImageProcessor imageProcessor_;                         // 调度线程使用的图像处理器
+    std::vector<std::unique_ptr<Stream>> streams_;          // 各路视频流
+    std::deque<InFlightFrame> inFlight_;                    // 正在推理的帧
+    size_t nextStream_ = 0;                                 // 轮转位置
+    FrameResult frameResult_;                               // 复用的推理结果
+    std::vector<DetectionResult> filtered_;                 // 复用的NMS结果
+    std::chrono::steady_clock::time_point runStart_;        // 调度开始时间
+    std::chrono::steady_clock::time_point runEnd_;          // 调度结束时间
+};
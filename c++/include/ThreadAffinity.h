@@ -0,0 +1,18 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// 线程CPU亲和性工具
+// 为采集、检测、跟踪、主线程分别指定核心，避免与OpenVINO推理线程和OpenCV线程池争抢同一批核心
+class ThreadAffinity {
+public:
+    // 解析核心列表，如"0,2,4-7"；空字符串返回空列表，格式错误时抛出std::invalid_argument
+    static std::vector<int> parseCoreList(const std::string& text);
+
+    // 将当前线程绑定到指定核心；列表为空时不做处理并返回true，系统调用失败或平台不支持时返回false
+    static bool pinCurrentThread(const std::vector<int>& cores);
+
+    // 将核心列表格式化为"0,2,4"
+    static std::string formatCoreList(const std::vector<int>& cores);
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+// 追踪事件记录（Chrome trace-event JSON，可用chrome://tracing或ui.perfetto.dev打开）
+// 每个线程写入自己的无锁SPSC环形缓冲区，后台线程定期取出并写入文件，热路径上不加锁、不做IO；
+// 未启动时TraceZone只读取一个原子标志
+class TraceRecorder {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // 开始记录到path，已在记录时先停止上一次记录；文件无法创建时返回false
+    static bool start(const std::string& path);
+
+    // 停止记录，写出剩余事件并关闭文件
+    static void stop();
+
+    // 是否正在记录
+    static bool isEnabled() {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    // 设置当前线程在追踪视图中显示的名称
+    static void setThreadName(const std::string& name);
+
+    // 记录一个完整的区间事件（name须为字符串常量），frameIndex<0时不输出帧序号
+    static void record(const char* name, Clock::time_point begin, Clock::time_point end, long long frameIndex);
+
+    // 获取因缓冲区已满而丢弃的事件数
+    static long long getDroppedEvents();
+
+private:
+    static std::atomic<bool> enabled_;          // 是否正在记录
+};
+
+// 作用域区间：构造时开始、析构时结束（也可提前调用end），生成一个追踪区间事件
+class TraceZone {
+public:
+    explicit TraceZone(const char* name, long long frameIndex = -1)
+        : name_(name), frameIndex_(frameIndex), active_(TraceRecorder::isEnabled()) {
+        if (active_) begin_ = TraceRecorder::Clock::now();
+    }
+
+    ~TraceZone() {
+        end();
+    }
+
+    TraceZone(const TraceZone&) = delete;
+    TraceZone& operator=(const TraceZone&) = delete;
+
+    // 提前结束区间
+    void end() {
+        if (active_) {
+            TraceRecorder::record(name_, begin_, TraceRecorder::Clock::now(), frameIndex_);
+            active_ = false;
+        }
+    }
+
+private:
+    const char* name_;                          // 区间名称
+    long long frameIndex_;                      // 帧序号
+    bool active_;                               // 构造时是否正在记录
+    TraceRecorder::Clock::time_point begin_;    // 开始时间
+};
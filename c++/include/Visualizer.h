@@ -1,9 +1,11 @@
 #pragma once
 
 #include <opencv2/opencv.hpp>
+#include <array>
 #include <vector>
 #include <string>
 #include "Detector.h"
+#include "PerformanceMonitor.h"
 
 // 前向声明
 class STrack;
@@ -20,11 +22,12 @@ public:
     // 绘制跟踪结果
     void drawTracks(cv::Mat& image, const std::vector<STrack>& tracks);
     
-    // 绘制性能信息
-    void drawPerformanceInfo(cv::Mat& image, double fps, double inferenceTime);
+    // 绘制性能信息（latency < 0 时不绘制采集到出结果的延迟，未设置帧预算时不绘制超时计数）
+    void drawPerformanceInfo(cv::Mat& image, double fps, double inferenceTime, double latency = -1.0,
+                             const DeadlineStats& deadline = DeadlineStats());
     
     // 绘制关键点
-    void drawLandmarks(cv::Mat& image, const std::vector<cv::Point2f>& landmarks);
+    void drawLandmarks(cv::Mat& image, const std::array<cv::Point2f, 4>& landmarks);
     
     // 绘制边界框
     void drawBoundingBox(cv::Mat& image, const cv::Rect& box, const std::string& label, 
@@ -19,6 +19,9 @@ public:
 	Scalar get_color(int idx);
 
 private:
+	// 基准测试（tracker_benchmark）直接调用下面的匹配和轨迹集合函数
+	friend struct BYTETrackerBenchmarkAccess;
+
 	vector<STrack*> joint_stracks(vector<STrack*> &tlista, vector<STrack> &tlistb);
 	vector<STrack> joint_stracks(vector<STrack> &tlista, vector<STrack> &tlistb);
 
@@ -1,4 +1,5 @@
 #include "BYTETracker.h"
+#include "../../../include/TraceRecorder.h"
 #include <fstream>
 
 BYTETracker::BYTETracker(int frame_rate, int track_buffer)
@@ -18,6 +19,7 @@ BYTETracker::~BYTETracker()
 
 vector<STrack> BYTETracker::update(const vector<Object>& objects)
 {
+	TraceZone updateZone("BYTETracker::update");
 
 	////////////////// Step 1: Get detections //////////////////
 	this->frame_id++;
@@ -74,6 +76,7 @@ vector<STrack> BYTETracker::update(const vector<Object>& objects)
 	}
 
 	////////////////// Step 2: First association, with IoU //////////////////
+	TraceZone firstAssociationZone("BYTETracker::firstAssociation");
 	strack_pool = joint_stracks(tracked_stracks, this->lost_stracks);
 	STrack::multi_predict(strack_pool, this->kalman_filter);
 
@@ -101,7 +104,10 @@ vector<STrack> BYTETracker::update(const vector<Object>& objects)
 		}
 	}
 
+	firstAssociationZone.end();
+
 	////////////////// Step 3: Second association, using low score dets //////////////////
+	TraceZone secondAssociationZone("BYTETracker::secondAssociation");
 	for (int i = 0; i < u_detection.size(); i++)
 	{
 		detections_cp.push_back(detections[u_detection[i]]);
@@ -151,7 +157,10 @@ vector<STrack> BYTETracker::update(const vector<Object>& objects)
 		}
 	}
 
+	secondAssociationZone.end();
+
 	// Deal with unconfirmed tracks, usually tracks with only one beginning frame
+	TraceZone unconfirmedZone("BYTETracker::unconfirmedAssociation");
 	detections.clear();
 	detections.assign(detections_cp.begin(), detections_cp.end());
 
@@ -176,7 +185,10 @@ vector<STrack> BYTETracker::update(const vector<Object>& objects)
 		removed_stracks.push_back(*track);
 	}
 
+	unconfirmedZone.end();
+
 	////////////////// Step 4: Init new stracks //////////////////
+	TraceZone updateStateZone("BYTETracker::updateState");
 	for (int i = 0; i < u_detection.size(); i++)
 	{
 		STrack *track = &detections[u_detection[i]];
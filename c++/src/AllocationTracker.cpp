@@ -0,0 +1,219 @@
+#include "../include/AllocationTracker.h"
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#if defined(_MSC_VER)
+#pragma comment(lib, "psapi.lib")
+#endif
+#elif defined(__linux__)
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+const char* const kStageNames[AllocationTracker::StageCount] = {
+    "other", "capture", "detect", "nms", "track", "draw"
+};
+
+// 单个线程的计数：只由所属线程写入，统计时由其他线程读取
+// 计数槽是静态数组，operator new中登记线程时不会再次分配
+struct ThreadCounters {
+    std::atomic<unsigned long long> allocations[AllocationTracker::StageCount];
+    std::atomic<unsigned long long> bytes[AllocationTracker::StageCount];
+    std::atomic<unsigned long long> deallocations[AllocationTracker::StageCount];
+};
+
+// 超出槽位数的线程（如推理库的大量工作线程）共用最后一个槽，计数用原子加保证不丢失
+constexpr int kMaxThreads = 256;
+ThreadCounters g_counters[kMaxThreads];
+std::atomic<int> g_threadCount{0};
+
+// 当前线程所在的阶段
+thread_local AllocationTracker::Stage t_stage = AllocationTracker::OtherStage;
+
+int registeredSlots() {
+    int count = g_threadCount.load(std::memory_order_relaxed);
+    return count < kMaxThreads ? count : kMaxThreads;
+}
+
+#if defined(DETECTION_ALLOC_STATS)
+// 当前线程的计数槽，首次分配时登记
+thread_local int t_slot = -1;
+
+ThreadCounters& currentCounters() {
+    if (t_slot < 0) {
+        int slot = g_threadCount.fetch_add(1, std::memory_order_relaxed);
+        t_slot = slot < kMaxThreads ? slot : kMaxThreads - 1;
+    }
+    return g_counters[t_slot];
+}
+
+void countAllocation(size_t size) {
+    ThreadCounters& counters = currentCounters();
+    counters.allocations[t_stage].fetch_add(1, std::memory_order_relaxed);
+    counters.bytes[t_stage].fetch_add(size, std::memory_order_relaxed);
+}
+
+void countDeallocation() {
+    ThreadCounters& counters = currentCounters();
+    counters.deallocations[t_stage].fetch_add(1, std::memory_order_relaxed);
+}
+
+void* allocate(size_t size) {
+    countAllocation(size);
+    // 与标准实现一致：0字节也返回唯一的非空指针
+    return std::malloc(size ? size : 1);
+}
+
+void deallocate(void* ptr) {
+    if (!ptr) return;
+    countDeallocation();
+    std::free(ptr);
+}
+#endif
+
+} // namespace
+
+#if defined(DETECTION_ALLOC_STATS)
+// ==================== 全局operator new/delete钩子 ====================
+// 只替换普通和nothrow版本；对齐版本（align_val_t）保留标准实现，成对分配和释放，不计数
+void* operator new(size_t size) {
+    void* ptr = allocate(size);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[](size_t size) {
+    void* ptr = allocate(size);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    deallocate(ptr);
+}
+#endif
+
+void AllocationTracker::reset() {
+    int slots = registeredSlots();
+    for (int i = 0; i < slots; ++i) {
+        for (int stage = 0; stage < StageCount; ++stage) {
+            g_counters[i].allocations[stage].store(0, std::memory_order_relaxed);
+            g_counters[i].bytes[stage].store(0, std::memory_order_relaxed);
+            g_counters[i].deallocations[stage].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+AllocationTracker::StageStats AllocationTracker::getStageStats(Stage stage) {
+    StageStats stats;
+    int slots = registeredSlots();
+    for (int i = 0; i < slots; ++i) {
+        stats.allocations += g_counters[i].allocations[stage].load(std::memory_order_relaxed);
+        stats.bytes += g_counters[i].bytes[stage].load(std::memory_order_relaxed);
+        stats.deallocations += g_counters[i].deallocations[stage].load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+const char* AllocationTracker::getStageName(Stage stage) {
+    return kStageNames[stage];
+}
+
+size_t AllocationTracker::getPeakResidentBytes() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize;
+    }
+    return 0;
+#elif defined(__linux__)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        return static_cast<size_t>(usage.ru_maxrss) * 1024;   // Linux下单位为KB
+    }
+    return 0;
+#else
+    return 0;
+#endif
+}
+
+void AllocationTracker::printStatistics(long long frames) {
+    std::cout << "\n=== Allocation Statistics ===" << std::endl;
+    if (isEnabled()) {
+        std::cout << "Frames: " << frames << std::endl;
+        std::cout << std::left << std::setw(10) << "Stage"
+                  << std::right << std::setw(14) << "Allocs"
+                  << std::setw(14) << "Allocs/frame"
+                  << std::setw(14) << "KB/frame"
+                  << std::setw(14) << "Frees" << std::endl;
+        double divisor = frames > 0 ? static_cast<double>(frames) : 1.0;
+        StageStats total;
+        for (int i = 0; i < StageCount; ++i) {
+            StageStats stats = getStageStats(static_cast<Stage>(i));
+            total.allocations += stats.allocations;
+            total.bytes += stats.bytes;
+            total.deallocations += stats.deallocations;
+            std::cout << std::left << std::setw(10) << kStageNames[i]
+                      << std::right << std::setw(14) << stats.allocations
+                      << std::fixed << std::setprecision(1)
+                      << std::setw(14) << stats.allocations / divisor
+                      << std::setw(14) << stats.bytes / 1024.0 / divisor
+                      << std::setw(14) << stats.deallocations << std::endl;
+        }
+        std::cout << std::left << std::setw(10) << "total"
+                  << std::right << std::setw(14) << total.allocations
+                  << std::setw(14) << total.allocations / divisor
+                  << std::setw(14) << total.bytes / 1024.0 / divisor
+                  << std::setw(14) << total.deallocations << std::endl;
+        if (g_threadCount.load(std::memory_order_relaxed) > kMaxThreads) {
+            std::cout << "Threads beyond " << kMaxThreads << " share one counter slot" << std::endl;
+        }
+    } else {
+        std::cout << "Per-stage counters not compiled in (configure with -DDETECTION_ALLOC_STATS=ON)" << std::endl;
+    }
+    std::cout << "Peak RSS: " << std::fixed << std::setprecision(1)
+              << getPeakResidentBytes() / (1024.0 * 1024.0) << " MB" << std::endl;
+    std::cout << std::defaultfloat;
+    std::cout << "==================================" << std::endl;
+}
+
+AllocationTracker::Stage AllocationTracker::enterStage(Stage stage) {
+    Stage previous = t_stage;
+    t_stage = stage;
+    return previous;
+}
@@ -8,7 +8,40 @@ Config::Config()
       device_("CPU"),
       detectColor_(1),
       confidenceThreshold_(0.45f),
-      nmsThreshold_(0.45f) {
+      nmsThreshold_(0.45f),
+      numInferRequests_(1),
+      useModelPreprocess_(false),
+      performanceMode_("LATENCY"),
+      batchSize_(1),
+      cacheDir_(""),
+      warmupIterations_(0),
+      inferencePrecision_(""),
+      int8ModelPath_("D:/RM26-DetectionModel/model/0708_int8.xml"),
+      roiMode_(false),
+      roiFullFrameInterval_(10),
+      roiMargin_(0.5f),
+      nmsMode_("QUAD"),
+      nmsMergeLandmarks_(false),
+      threadedPipeline_(false),
+      pipelineQueueSize_(4),
+      captureMode_("SEQUENTIAL"),
+      headless_(false),
+      resultOutputPath_(""),
+      framePoolSize_(16),
+      inferenceNumThreads_(0),
+      numStreams_(0),
+      cpuPinning_(-1),
+      hyperThreading_(-1),
+      opencvThreads_(-1),
+      captureCores_(""),
+      inferCores_(""),
+      trackCores_(""),
+      outputCores_(""),
+      traceOutputPath_(""),
+      enableProfiling_(false),
+      profilingTopN_(20),
+      profilingCsvPath_("layer_profile.csv"),
+      frameDeadlineMs_(0.0) {
 }
 
 void Config::setModelPath(const std::string& path) {
@@ -59,6 +92,274 @@ float Config::getNMSThreshold() const {
     return nmsThreshold_;
 }
 
+void Config::setNumInferRequests(int count) {
+    numInferRequests_ = count;
+}
+
+int Config::getNumInferRequests() const {
+    return numInferRequests_;
+}
+
+void Config::setUseModelPreprocess(bool enable) {
+    useModelPreprocess_ = enable;
+}
+
+bool Config::getUseModelPreprocess() const {
+    return useModelPreprocess_;
+}
+
+void Config::setPerformanceMode(const std::string& mode) {
+    performanceMode_ = mode;
+}
+
+std::string Config::getPerformanceMode() const {
+    return performanceMode_;
+}
+
+void Config::setBatchSize(int size) {
+    batchSize_ = size;
+}
+
+int Config::getBatchSize() const {
+    return batchSize_;
+}
+
+void Config::setCacheDir(const std::string& dir) {
+    cacheDir_ = dir;
+}
+
+void Config::setWarmupIterations(int iterations) {
+    warmupIterations_ = iterations;
+}
+
+std::string Config::getCacheDir() const {
+    return cacheDir_;
+}
+
+int Config::getWarmupIterations() const {
+    return warmupIterations_;
+}
+
+void Config::setInferencePrecision(const std::string& precision) {
+    inferencePrecision_ = precision;
+}
+
+void Config::setInt8ModelPath(const std::string& path) {
+    int8ModelPath_ = path;
+}
+
+std::string Config::getInferencePrecision() const {
+    return inferencePrecision_;
+}
+
+std::string Config::getInt8ModelPath() const {
+    return int8ModelPath_;
+}
+
+std::string Config::getModelPathForPrecision(const std::string& precision) const {
+    return precision == "INT8" ? int8ModelPath_ : modelPath_;
+}
+
+void Config::setRoiMode(bool enable) {
+    roiMode_ = enable;
+}
+
+void Config::setRoiFullFrameInterval(int interval) {
+    roiFullFrameInterval_ = interval;
+}
+
+void Config::setRoiMargin(float margin) {
+    roiMargin_ = margin;
+}
+
+bool Config::getRoiMode() const {
+    return roiMode_;
+}
+
+int Config::getRoiFullFrameInterval() const {
+    return roiFullFrameInterval_;
+}
+
+float Config::getRoiMargin() const {
+    return roiMargin_;
+}
+
+void Config::setNMSMode(const std::string& mode) {
+    nmsMode_ = mode;
+}
+
+void Config::setNMSMergeLandmarks(bool enable) {
+    nmsMergeLandmarks_ = enable;
+}
+
+std::string Config::getNMSMode() const {
+    return nmsMode_;
+}
+
+bool Config::getNMSMergeLandmarks() const {
+    return nmsMergeLandmarks_;
+}
+
+void Config::setThreadedPipeline(bool enable) {
+    threadedPipeline_ = enable;
+}
+
+void Config::setPipelineQueueSize(int size) {
+    pipelineQueueSize_ = size;
+}
+
+bool Config::getThreadedPipeline() const {
+    return threadedPipeline_;
+}
+
+int Config::getPipelineQueueSize() const {
+    return pipelineQueueSize_;
+}
+
+void Config::setCaptureMode(const std::string& mode) {
+    captureMode_ = mode;
+}
+
+std::string Config::getCaptureMode() const {
+    return captureMode_;
+}
+
+void Config::setHeadless(bool enable) {
+    headless_ = enable;
+}
+
+void Config::setResultOutputPath(const std::string& path) {
+    resultOutputPath_ = path;
+}
+
+bool Config::getHeadless() const {
+    return headless_;
+}
+
+std::string Config::getResultOutputPath() const {
+    return resultOutputPath_;
+}
+
+void Config::setFramePoolSize(int size) {
+    framePoolSize_ = size;
+}
+
+int Config::getFramePoolSize() const {
+    return framePoolSize_;
+}
+
+void Config::setInferenceNumThreads(int threads) {
+    inferenceNumThreads_ = threads;
+}
+
+int Config::getInferenceNumThreads() const {
+    return inferenceNumThreads_;
+}
+
+void Config::setNumStreams(int streams) {
+    numStreams_ = streams;
+}
+
+int Config::getNumStreams() const {
+    return numStreams_;
+}
+
+void Config::setCpuPinning(int mode) {
+    cpuPinning_ = mode;
+}
+
+int Config::getCpuPinning() const {
+    return cpuPinning_;
+}
+
+void Config::setHyperThreading(int mode) {
+    hyperThreading_ = mode;
+}
+
+int Config::getHyperThreading() const {
+    return hyperThreading_;
+}
+
+void Config::setOpenCVThreads(int threads) {
+    opencvThreads_ = threads;
+}
+
+int Config::getOpenCVThreads() const {
+    return opencvThreads_;
+}
+
+void Config::setCaptureCores(const std::string& cores) {
+    captureCores_ = cores;
+}
+
+std::string Config::getCaptureCores() const {
+    return captureCores_;
+}
+
+void Config::setInferCores(const std::string& cores) {
+    inferCores_ = cores;
+}
+
+std::string Config::getInferCores() const {
+    return inferCores_;
+}
+
+void Config::setTrackCores(const std::string& cores) {
+    trackCores_ = cores;
+}
+
+std::string Config::getTrackCores() const {
+    return trackCores_;
+}
+
+void Config::setOutputCores(const std::string& cores) {
+    outputCores_ = cores;
+}
+
+std::string Config::getOutputCores() const {
+    return outputCores_;
+}
+
+void Config::setTraceOutputPath(const std::string& path) {
+    traceOutputPath_ = path;
+}
+
+std::string Config::getTraceOutputPath() const {
+    return traceOutputPath_;
+}
+
+void Config::setEnableProfiling(bool enable) {
+    enableProfiling_ = enable;
+}
+
+bool Config::getEnableProfiling() const {
+    return enableProfiling_;
+}
+
+void Config::setProfilingTopN(int count) {
+    profilingTopN_ = count;
+}
+
+int Config::getProfilingTopN() const {
+    return profilingTopN_;
+}
+
+void Config::setProfilingCsvPath(const std::string& path) {
+    profilingCsvPath_ = path;
+}
+
+std::string Config::getProfilingCsvPath() const {
+    return profilingCsvPath_;
+}
+
+void Config::setFrameDeadlineMs(double deadline) {
+    frameDeadlineMs_ = deadline;
+}
+
+double Config::getFrameDeadlineMs() const {
+    return frameDeadlineMs_;
+}
+
 bool Config::loadFromFile(const std::string& filename) {
     std::ifstream file(filename);
     if (!file.is_open()) {
@@ -91,6 +392,72 @@ bool Config::loadFromFile(const std::string& filename) {
                 confidenceThreshold_ = std::stof(value);
             } else if (key == "nms_threshold") {
                 nmsThreshold_ = std::stof(value);
+            } else if (key == "num_infer_requests") {
+                numInferRequests_ = std::stoi(value);
+            } else if (key == "model_preprocess") {
+                useModelPreprocess_ = std::stoi(value) != 0;
+            } else if (key == "performance_mode") {
+                performanceMode_ = value;
+            } else if (key == "batch_size") {
+                batchSize_ = std::stoi(value);
+            } else if (key == "cache_dir") {
+                cacheDir_ = value;
+            } else if (key == "warmup_iterations") {
+                warmupIterations_ = std::stoi(value);
+            } else if (key == "inference_precision") {
+                inferencePrecision_ = value;
+            } else if (key == "int8_model_path") {
+                int8ModelPath_ = value;
+            } else if (key == "roi_mode") {
+                roiMode_ = std::stoi(value) != 0;
+            } else if (key == "roi_full_frame_interval") {
+                roiFullFrameInterval_ = std::stoi(value);
+            } else if (key == "roi_margin") {
+                roiMargin_ = std::stof(value);
+            } else if (key == "nms_mode") {
+                nmsMode_ = value;
+            } else if (key == "nms_merge_landmarks") {
+                nmsMergeLandmarks_ = std::stoi(value) != 0;
+            } else if (key == "threaded_pipeline") {
+                threadedPipeline_ = std::stoi(value) != 0;
+            } else if (key == "pipeline_queue_size") {
+                pipelineQueueSize_ = std::stoi(value);
+            } else if (key == "capture_mode") {
+                captureMode_ = value;
+            } else if (key == "headless") {
+                headless_ = std::stoi(value) != 0;
+            } else if (key == "result_output_path") {
+                resultOutputPath_ = value;
+            } else if (key == "frame_pool_size") {
+                framePoolSize_ = std::stoi(value);
+            } else if (key == "inference_num_threads") {
+                inferenceNumThreads_ = std::stoi(value);
+            } else if (key == "num_streams") {
+                numStreams_ = std::stoi(value);
+            } else if (key == "cpu_pinning") {
+                cpuPinning_ = std::stoi(value);
+            } else if (key == "hyper_threading") {
+                hyperThreading_ = std::stoi(value);
+            } else if (key == "opencv_threads") {
+                opencvThreads_ = std::stoi(value);
+            } else if (key == "capture_cores") {
+                captureCores_ = value;
+            } else if (key == "infer_cores") {
+                inferCores_ = value;
+            } else if (key == "track_cores") {
+                trackCores_ = value;
+            } else if (key == "output_cores") {
+                outputCores_ = value;
+            } else if (key == "trace_output_path") {
+                traceOutputPath_ = value;
+            } else if (key == "enable_profiling") {
+                enableProfiling_ = std::stoi(value) != 0;
+            } else if (key == "profiling_top_n") {
+                profilingTopN_ = std::stoi(value);
+            } else if (key == "profiling_csv_path") {
+                profilingCsvPath_ = value;
+            } else if (key == "frame_deadline_ms") {
+                frameDeadlineMs_ = std::stod(value);
             }
         }
     }
@@ -112,6 +479,39 @@ bool Config::saveToFile(const std::string& filename) const {
     file << "detect_color=" << detectColor_ << std::endl;
     file << "confidence_threshold=" << confidenceThreshold_ << std::endl;
     file << "nms_threshold=" << nmsThreshold_ << std::endl;
+    file << "num_infer_requests=" << numInferRequests_ << std::endl;
+    file << "model_preprocess=" << (useModelPreprocess_ ? 1 : 0) << std::endl;
+    file << "performance_mode=" << performanceMode_ << std::endl;
+    file << "batch_size=" << batchSize_ << std::endl;
+    file << "cache_dir=" << cacheDir_ << std::endl;
+    file << "warmup_iterations=" << warmupIterations_ << std::endl;
+    file << "inference_precision=" << inferencePrecision_ << std::endl;
+    file << "int8_model_path=" << int8ModelPath_ << std::endl;
+    file << "roi_mode=" << (roiMode_ ? 1 : 0) << std::endl;
+    file << "roi_full_frame_interval=" << roiFullFrameInterval_ << std::endl;
+    file << "roi_margin=" << roiMargin_ << std::endl;
+    file << "nms_mode=" << nmsMode_ << std::endl;
+    file << "nms_merge_landmarks=" << (nmsMergeLandmarks_ ? 1 : 0) << std::endl;
+    file << "threaded_pipeline=" << (threadedPipeline_ ? 1 : 0) << std::endl;
+    file << "pipeline_queue_size=" << pipelineQueueSize_ << std::endl;
+    file << "capture_mode=" << captureMode_ << std::endl;
+    file << "headless=" << (headless_ ? 1 : 0) << std::endl;
+    file << "result_output_path=" << resultOutputPath_ << std::endl;
+    file << "frame_pool_size=" << framePoolSize_ << std::endl;
+    file << "inference_num_threads=" << inferenceNumThreads_ << std::endl;
+    file << "num_streams=" << numStreams_ << std::endl;
+    file << "cpu_pinning=" << cpuPinning_ << std::endl;
+    file << "hyper_threading=" << hyperThreading_ << std::endl;
+    file << "opencv_threads=" << opencvThreads_ << std::endl;
+    file << "capture_cores=" << captureCores_ << std::endl;
+    file << "infer_cores=" << inferCores_ << std::endl;
+    file << "track_cores=" << trackCores_ << std::endl;
+    file << "output_cores=" << outputCores_ << std::endl;
+    file << "trace_output_path=" << traceOutputPath_ << std::endl;
+    file << "enable_profiling=" << (enableProfiling_ ? 1 : 0) << std::endl;
+    file << "profiling_top_n=" << profilingTopN_ << std::endl;
+    file << "profiling_csv_path=" << profilingCsvPath_ << std::endl;
+    file << "frame_deadline_ms=" << frameDeadlineMs_ << std::endl;
     
     file.close();
     return true;
@@ -125,5 +525,38 @@ void Config::printConfig() const {
     std::cout << "Detection color: " << (detectColor_ == 0 ? "Red" : "Blue") << std::endl;
     std::cout << "Confidence threshold: " << confidenceThreshold_ << std::endl;
     std::cout << "NMS threshold: " << nmsThreshold_ << std::endl;
+    std::cout << "Infer requests: " << numInferRequests_ << std::endl;
+    std::cout << "Model preprocess: " << (useModelPreprocess_ ? "On" : "Off") << std::endl;
+    std::cout << "Performance mode: " << performanceMode_ << std::endl;
+    std::cout << "Batch size: " << batchSize_ << std::endl;
+    std::cout << "Model cache dir: " << (cacheDir_.empty() ? "(disabled)" : cacheDir_) << std::endl;
+    std::cout << "Warm-up iterations: " << warmupIterations_ << std::endl;
+    std::cout << "Inference precision: " << (inferencePrecision_.empty() ? "(device default)" : inferencePrecision_) << std::endl;
+    std::cout << "INT8 model path: " << int8ModelPath_ << std::endl;
+    std::cout << "ROI mode: " << (roiMode_ ? "On" : "Off") << std::endl;
+    std::cout << "ROI full-frame interval: " << roiFullFrameInterval_ << std::endl;
+    std::cout << "ROI margin: " << roiMargin_ << std::endl;
+    std::cout << "NMS mode: " << nmsMode_ << std::endl;
+    std::cout << "NMS merge landmarks: " << (nmsMergeLandmarks_ ? "On" : "Off") << std::endl;
+    std::cout << "Threaded pipeline: " << (threadedPipeline_ ? "On" : "Off") << std::endl;
+    std::cout << "Pipeline queue size: " << pipelineQueueSize_ << std::endl;
+    std::cout << "Capture mode: " << captureMode_ << std::endl;
+    std::cout << "Headless: " << (headless_ ? "On" : "Off") << std::endl;
+    std::cout << "Result output: " << (resultOutputPath_.empty() ? "(disabled)" : resultOutputPath_) << std::endl;
+    std::cout << "Frame pool size: " << framePoolSize_ << std::endl;
+    std::cout << "Inference threads: " << inferenceNumThreads_ << std::endl;
+    std::cout << "OpenVINO streams: " << numStreams_ << std::endl;
+    std::cout << "CPU pinning: " << cpuPinning_ << std::endl;
+    std::cout << "Hyper-threading: " << hyperThreading_ << std::endl;
+    std::cout << "OpenCV threads: " << opencvThreads_ << std::endl;
+    std::cout << "Capture cores: " << (captureCores_.empty() ? "(any)" : captureCores_) << std::endl;
+    std::cout << "Infer cores: " << (inferCores_.empty() ? "(any)" : inferCores_) << std::endl;
+    std::cout << "Track cores: " << (trackCores_.empty() ? "(any)" : trackCores_) << std::endl;
+    std::cout << "Output cores: " << (outputCores_.empty() ? "(any)" : outputCores_) << std::endl;
+    std::cout << "Trace output: " << (traceOutputPath_.empty() ? "(disabled)" : traceOutputPath_) << std::endl;
+    std::cout << "Layer profiling: " << (enableProfiling_ ? "On" : "Off") << std::endl;
+    std::cout << "Profiling top N: " << profilingTopN_ << std::endl;
+    std::cout << "Profiling CSV: " << (profilingCsvPath_.empty() ? "(disabled)" : profilingCsvPath_) << std::endl;
+    std::cout << "Frame deadline (ms): " << frameDeadlineMs_ << std::endl;
     std::cout << "==================================" << std::endl;
 } 
\ No newline at end of file
@@ -0,0 +1,40 @@
+#include "../include/CpuFeatures.h"
+
+#if defined(DETECTION_HAS_AVX2_KERNELS) && defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+namespace {
+
+bool detectAVX2() {
+#if !defined(DETECTION_HAS_AVX2_KERNELS)
+    return false;
+#elif defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+
+    // 叶1：ECX第12位FMA、第27位OSXSAVE、第28位AVX
+    __cpuid(info, 1);
+    const int fma = 1 << 12, osxsave = 1 << 27, avx = 1 << 28;
+    if ((info[2] & (fma | osxsave | avx)) != (fma | osxsave | avx)) return false;
+
+    // 操作系统需保存YMM寄存器状态（XCR0第1、2位）
+    if ((_xgetbv(0) & 0x6) != 0x6) return false;
+
+    // 叶7子叶0：EBX第5位AVX2
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+}
+
+} // namespace
+
+bool CpuFeatures::hasAVX2() {
+    static const bool supported = detectAVX2();
+    return supported;
+}
@@ -1,31 +1,155 @@
 #include "../include/Detector.h"
+#include "../include/TraceRecorder.h"
+#include <openvino/core/preprocess/pre_post_process.hpp>
 #include <iostream>
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+#include "../include/CpuFeatures.h"
+
+#if defined(DETECTION_HAS_AVX2_KERNELS)
+#include <immintrin.h>
+#define DETECTOR_USE_AVX2
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DETECTOR_USE_SSE2
+#endif
+
+namespace {
+
+#if defined(DETECTOR_USE_AVX2)
+// 每次按步长收集8行的置信度logit并与阈值比较，候选行追加到rows[count]，返回已扫描的行数
+DETECTION_TARGET_AVX2
+int scanLogitsAVX2(const float* column, int stride, int numBoxes, float logitThreshold, int* rows, int& count) {
+    const __m256 threshold = _mm256_set1_ps(logitThreshold);
+    const __m256i offsets = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                               _mm256_set1_epi32(stride));
+    int i = 0;
+    for (; i + 8 <= numBoxes; i += 8) {
+        __m256 logits = _mm256_i32gather_ps(column + i * stride, offsets, 4);
+        int mask = _mm256_movemask_ps(_mm256_cmp_ps(logits, threshold, _CMP_GE_OQ));
+        if (mask == 0) continue;
+        for (int k = 0; k < 8; ++k) {
+            if (mask & (1 << k)) rows[count++] = i + k;
+        }
+    }
+    _mm256_zeroupper();
+    return i;
+}
+#endif
+
+#if defined(DETECTOR_USE_SSE2)
+// 每次按步长读取4行的置信度logit并与阈值比较，候选行追加到rows[count]，返回已扫描的行数
+int scanLogitsSSE2(const float* column, int stride, int numBoxes, float logitThreshold, int* rows, int& count) {
+    const __m128 threshold = _mm_set1_ps(logitThreshold);
+    int i = 0;
+    for (; i + 4 <= numBoxes; i += 4) {
+        const float* p = column + i * stride;
+        __m128 logits = _mm_setr_ps(p[0], p[stride], p[2 * stride], p[3 * stride]);
+        int mask = _mm_movemask_ps(_mm_cmpge_ps(logits, threshold));
+        if (mask == 0) continue;
+        for (int k = 0; k < 4; ++k) {
+            if (mask & (1 << k)) rows[count++] = i + k;
+        }
+    }
+    return i;
+}
+#endif
+
+} // namespace
 
 Detector::Detector(const std::string& modelPath, const std::string& device) {
     initializeModel(modelPath, device);
 }
 
+Detector::Detector(const std::string& modelPath, const std::string& device, const DetectorOptions& options)
+    : options_(options) {
+    initializeModel(modelPath, device);
+}
+
 void Detector::initializeModel(const std::string& modelPath, const std::string& device) {
     try {
+        auto loadStart = std::chrono::high_resolution_clock::now();
+        
+        // 编译模型缓存：键由OpenVINO根据模型哈希、设备和编译选项生成，命中时跳过编译
+        if (!options_.cacheDir.empty()) {
+            core_.set_property(ov::cache_dir(options_.cacheDir));
+        }
+        
         // 读取模型
         std::shared_ptr<ov::Model> model = core_.read_model(modelPath);
         
-        // 编译模型
-        compiledModel_ = core_.compile_model(model, device);
+        // 获取输入尺寸（以原始模型为准，图内预处理后输入端口的空间维度是动态的）
+        auto inputShape = model->input().get_shape();
+        inputSize_ = cv::Size(inputShape[3], inputShape[2]); // NCHW格式
         
-        // 创建推理请求
-        inferRequest_ = compiledModel_.create_infer_request();
+        // 批量推理：N维改为动态范围[1, batchSize]，单帧与多帧推理共用一个编译模型
+        if (options_.batchSize > 1) {
+            model->reshape(ov::PartialShape{ov::Dimension(1, options_.batchSize), 
+                                            static_cast<int64_t>(inputShape[1]),
+                                            static_cast<int64_t>(inputShape[2]),
+                                            static_cast<int64_t>(inputShape[3])});
+        }
+        
+        // 图内预处理：直接接收任意尺寸的u8 NHWC BGR帧，由运行时完成缩放、颜色转换和归一化
+        if (options_.useModelPreprocess) {
+            ov::preprocess::PrePostProcessor ppp(model);
+            ppp.input().tensor()
+                .set_element_type(ov::element::u8)
+                .set_layout("NHWC")
+                .set_color_format(ov::preprocess::ColorFormat::BGR)
+                .set_spatial_dynamic_shape();
+            ppp.input().preprocess()
+                .convert_element_type(ov::element::f32)
+                .convert_color(ov::preprocess::ColorFormat::RGB)
+                .resize(ov::preprocess::ResizeAlgorithm::RESIZE_LINEAR)
+                .scale(255.0f);
+            ppp.input().model().set_layout("NCHW");
+            model = ppp.build();
+        }
+        
+        // 编译模型
+        compiledModel_ = core_.compile_model(model, device, buildCompileConfig());
         
         // 获取输入输出端口
         inputPort_ = compiledModel_.input();
         outputPort_ = compiledModel_.output();
         
-        // 获取输入尺寸
-        auto inputShape = inputPort_.get_shape();
-        inputSize_ = cv::Size(inputShape[3], inputShape[2]); // NCHW格式
+        // 获取输出尺寸 (N, numBoxes, numAttrs)，N维可能是动态的
+        auto outputShape = outputPort_.get_partial_shape();
+        numBoxes_ = static_cast<int>(outputShape[1].get_length());
+        numAttrs_ = static_cast<int>(outputShape[2].get_length());
+        candidateRows_.resize(numBoxes_);
+        
+        // sigmoid单调递增，sigmoid(x) >= t 等价于 x >= log(t / (1 - t))，筛选时无需计算exp
+        float threshold = std::min(std::max(options_.confidenceThreshold, 1e-6f), 1.0f - 1e-6f);
+        logitThreshold_ = std::log(threshold / (1.0f - threshold));
+        
+        // 创建推理槽，每个槽拥有独立的推理请求和常驻张量
+        // 未指定推理请求数量时使用设备推荐值（吞吐模式下即为并行流数量）
+        int numRequests = options_.numInferRequests;
+        if (numRequests <= 0) {
+            numRequests = static_cast<int>(compiledModel_.get_property(ov::optimal_number_of_infer_requests));
+        }
+        numRequests = std::max(1, numRequests);
+        slots_.resize(numRequests);
+        for (auto& slot : slots_) {
+            initializeSlot(slot);
+        }
+        
+        auto loadEnd = std::chrono::high_resolution_clock::now();
+        loadTimeMs_ = std::chrono::duration<double, std::milli>(loadEnd - loadStart).count();
         
-        std::cout << "Model loaded successfully. Input size: " << inputSize_ << std::endl;
+        std::cout << "Model loaded successfully in " << loadTimeMs_ << " ms. Input size: " << inputSize_
+                  << ", infer requests: " << slots_.size()
+                  << ", batch size: " << getBatchSize()
+                  << ", model preprocess: " << (options_.useModelPreprocess ? "on" : "off")
+                  << ", performance mode: " << compiledModel_.get_property(ov::hint::performance_mode)
+                  << ", precision: " << (options_.inferencePrecision.empty() ? "default" : options_.inferencePrecision)
+                  << (options_.enableProfiling ? ", layer profiling: on" : "") << std::endl;
     }
     catch (const std::exception& e) {
         std::cerr << "Error initializing model: " << e.what() << std::endl;
@@ -33,71 +157,294 @@ void Detector::initializeModel(const std::string& modelPath, const std::string&
     }
 }
 
+ov::AnyMap Detector::buildCompileConfig() const {
+    ov::AnyMap compileConfig;
+    
+    if (!options_.performanceMode.empty()) {
+        ov::hint::PerformanceMode mode;
+        if (options_.performanceMode == "LATENCY") {
+            mode = ov::hint::PerformanceMode::LATENCY;
+        } else if (options_.performanceMode == "THROUGHPUT") {
+            mode = ov::hint::PerformanceMode::THROUGHPUT;
+        } else if (options_.performanceMode == "CUMULATIVE_THROUGHPUT") {
+            mode = ov::hint::PerformanceMode::CUMULATIVE_THROUGHPUT;
+        } else {
+            throw std::invalid_argument("Unknown performance mode: " + options_.performanceMode);
+        }
+        compileConfig.insert(ov::hint::performance_mode(mode));
+    }
+    
+    // INT8量化模型的精度由模型中的量化节点决定，无需设置精度提示
+    if (!options_.inferencePrecision.empty() && options_.inferencePrecision != "INT8") {
+        ov::element::Type precision;
+        if (options_.inferencePrecision == "FP32") {
+            precision = ov::element::f32;
+        } else if (options_.inferencePrecision == "BF16") {
+            precision = ov::element::bf16;
+        } else if (options_.inferencePrecision == "FP16") {
+            precision = ov::element::f16;
+        } else {
+            throw std::invalid_argument("Unknown inference precision: " + options_.inferencePrecision);
+        }
+        compileConfig.insert(ov::hint::inference_precision(precision));
+    }
+    
+    // 线程和流：显式限定OpenVINO占用的核心数量，为采集、跟踪等线程留出核心，避免超额订阅
+    if (options_.inferenceNumThreads > 0) {
+        compileConfig.insert(ov::inference_num_threads(options_.inferenceNumThreads));
+    }
+    if (options_.numStreams > 0) {
+        compileConfig.insert(ov::num_streams(options_.numStreams));
+    } else if (options_.numStreams < 0) {
+        compileConfig.insert(ov::num_streams(ov::streams::AUTO));
+    }
+    if (options_.cpuPinning >= 0) {
+        compileConfig.insert(ov::hint::enable_cpu_pinning(options_.cpuPinning != 0));
+    }
+    if (options_.hyperThreading >= 0) {
+        compileConfig.insert(ov::hint::enable_hyper_threading(options_.hyperThreading != 0));
+    }
+    
+    // 逐层性能计数有少量额外开销，只在分析模型时开启
+    if (options_.enableProfiling) {
+        compileConfig.insert(ov::enable_profiling(true));
+    }
+    
+    return compileConfig;
+}
+
+void Detector::initializeSlot(InferSlot& slot) {
+    slot.request = compiledModel_.create_infer_request();
+    
+    // 输出张量在检测器生命周期内常驻，按最大批大小分配，推理结果直接写入其中
+    size_t maxBatch = static_cast<size_t>(getBatchSize());
+    slot.outputTensor = ov::Tensor(outputPort_.get_element_type(), 
+                                   ov::Shape{maxBatch, static_cast<size_t>(numBoxes_), static_cast<size_t>(numAttrs_)});
+    slot.request.set_output_tensor(slot.outputTensor);
+    slot.batchCount = static_cast<int>(maxBatch);
+    
+    // 图内预处理模式下输入尺寸随帧变化，输入张量在首帧时分配
+    if (!options_.useModelPreprocess) {
+        slot.inputTensor = ov::Tensor(inputPort_.get_element_type(), 
+                                      ov::Shape{maxBatch, 3, static_cast<size_t>(inputSize_.height), static_cast<size_t>(inputSize_.width)});
+        slot.request.set_input_tensor(slot.inputTensor);
+    }
+}
+
+void Detector::resizeSlot(InferSlot& slot, int batchCount, const cv::Size& frameSize) {
+    // 图内预处理模式：首帧时分配u8输入张量，之后帧尺寸变化只调整H、W维
+    // 张量保留出现过的最大容量，多路不同分辨率的流交替时不重新分配，也不重新绑定到推理请求
+    if (options_.useModelPreprocess && frameSize != slot.inputFrameSize) {
+        if (!slot.inputTensor) {
+            slot.inputTensor = ov::Tensor(ov::element::u8,
+                                          ov::Shape{static_cast<size_t>(slot.batchCount), static_cast<size_t>(frameSize.height), 
+                                                    static_cast<size_t>(frameSize.width), 3});
+            slot.request.set_input_tensor(slot.inputTensor);
+        } else {
+            ov::Shape inputShape = slot.inputTensor.get_shape();
+            inputShape[1] = static_cast<size_t>(frameSize.height);
+            inputShape[2] = static_cast<size_t>(frameSize.width);
+            slot.inputTensor.set_shape(inputShape);
+        }
+        slot.inputFrameSize = frameSize;
+    }
+    
+    // 批大小变化时调整N维，缩小时保留原有容量
+    if (batchCount != slot.batchCount) {
+        ov::Shape inputShape = slot.inputTensor.get_shape();
+        inputShape[0] = static_cast<size_t>(batchCount);
+        slot.inputTensor.set_shape(inputShape);
+        
+        ov::Shape outputShape = slot.outputTensor.get_shape();
+        outputShape[0] = static_cast<size_t>(batchCount);
+        slot.outputTensor.set_shape(outputShape);
+        
+        slot.batchCount = batchCount;
+    }
+}
+
 std::vector<DetectionResult> Detector::detect(const cv::Mat& frame, int detectColor) {
-    // 预处理图像
-    std::vector<float> inputTensor = preprocessImage(frame);
+    std::vector<DetectionResult> results;
+    detect(frame, results, detectColor);
+    return results;
+}
+
+void Detector::detect(const cv::Mat& frame, std::vector<DetectionResult>& results, int detectColor) {
+    InferSlot& slot = acquireIdleSlot();
+    startSlot(slot, frame, detectColor, -1);
+    finishSlot(slot, results);
+    slot.frame.release();
+}
+
+void Detector::detectBatch(const std::vector<cv::Mat>& frames, 
+                           std::vector<std::vector<DetectionResult>>& results,
+                           int detectColor) {
+    results.resize(frames.size());
+    
+    const size_t maxBatch = static_cast<size_t>(getBatchSize());
+    const size_t outputStride = static_cast<size_t>(numBoxes_) * numAttrs_;
+    InferSlot& slot = acquireIdleSlot();
     
-    // 创建输入张量
-    ov::Tensor input = ov::Tensor(inputPort_.get_element_type(), 
-                                 ov::Shape{1, 3, static_cast<size_t>(inputSize_.height), static_cast<size_t>(inputSize_.width)}, 
-                                 inputTensor.data());
+    for (size_t offset = 0; offset < frames.size(); offset += maxBatch) {
+        int count = static_cast<int>(std::min(maxBatch, frames.size() - offset));
+        const cv::Size frameSize = frames[offset].size();
+        resizeSlot(slot, count, frameSize);
+        
+        // 依次写入同一批的各帧
+        for (int b = 0; b < count; ++b) {
+            const cv::Mat& frame = frames[offset + b];
+            if (options_.useModelPreprocess && frame.size() != frameSize) {
+                throw std::invalid_argument("All frames in a batch must have the same size when model preprocessing is enabled");
+            }
+            prepareInput(slot, frame, b);
+        }
+        
+        // 一次推理处理整批
+        {
+            TraceZone zone("Detector::infer");
+            slot.request.infer();
+        }
+        accumulateLayerProfiles(slot.request);
+        
+        // 逐帧后处理
+        const float* outputData = slot.outputTensor.data<float>();
+        for (int b = 0; b < count; ++b) {
+            postprocessResults(outputData + b * outputStride, detectColor, results[offset + b]);
+        }
+    }
+}
+
+bool Detector::detectPipelined(const cv::Mat& frame, int detectColor, FrameResult& result,
+                               std::chrono::steady_clock::time_point captureTime) {
+    // 在空闲槽中预处理当前帧并启动异步推理，此时前面提交的帧仍在推理中
+    submit(frame, detectColor, captureTime);
     
-    // 设置输入
-    inferRequest_.set_input_tensor(input);
+    // 流水线尚未填满，暂不输出结果
+    if (pendingCount_ < slots_.size()) {
+        return false;
+    }
     
-    // 执行推理
-    inferRequest_.infer();
+    // 等待最早提交的帧，保证输出顺序与提交顺序一致
+    return flushPipeline(result);
+}
+
+bool Detector::flushPipeline(FrameResult& result) {
+    if (pendingCount_ == 0) {
+        return false;
+    }
     
-    // 获取输出
-    ov::Tensor output = inferRequest_.get_output_tensor();
-    float* outputData = output.data<float>();
-    auto outputShape = output.get_shape();
+    size_t oldest = (nextSlot_ + slots_.size() - pendingCount_) % slots_.size();
+    InferSlot& slot = slots_[oldest];
+    finishSlot(slot, result.detections);
+    result.frameIndex = slot.frameIndex;
+    result.frame = slot.frame;
+    result.captureTime = slot.captureTime;
     
-    // 后处理结果
-    std::vector<int> shape(outputShape.begin(), outputShape.end());
-    return postprocessResults(outputData, shape, detectColor);
+    // 释放对原始帧的引用
+    slot.frame.release();
+    pendingCount_--;
+    return true;
 }
 
-std::vector<float> Detector::preprocessImage(const cv::Mat& frame) {
-    // 调整图像尺寸
-    cv::Mat resized;
-    cv::resize(frame, resized, inputSize_);
+long long Detector::submit(const cv::Mat& frame, int detectColor,
+                           std::chrono::steady_clock::time_point captureTime) {
+    if (!canSubmit()) {
+        throw std::logic_error("No free infer request: flush a result before submitting");
+    }
     
-    // 转换颜色空间
-    cv::Mat rgb;
-    cv::cvtColor(resized, rgb, cv::COLOR_BGR2RGB);
+    InferSlot& slot = slots_[nextSlot_];
+    startSlot(slot, frame, detectColor, submittedFrames_++);
+    slot.captureTime = captureTime;
+    nextSlot_ = (nextSlot_ + 1) % slots_.size();
+    pendingCount_++;
+    return slot.frameIndex;
+}
+
+bool Detector::canSubmit() const {
+    return pendingCount_ < slots_.size();
+}
+
+int Detector::getPendingCount() const {
+    return static_cast<int>(pendingCount_);
+}
+
+Detector::InferSlot& Detector::acquireIdleSlot() {
+    // nextSlot_在有空闲槽时总是空闲的；同步调用不推进nextSlot_，用完后该槽仍可供submit使用
+    if (!canSubmit()) {
+        throw std::logic_error("No free infer request: flush pipelined results before synchronous detection");
+    }
+    return slots_[nextSlot_];
+}
+
+void Detector::startSlot(InferSlot& slot, const cv::Mat& frame, int detectColor, long long frameIndex) {
+    // 将帧写入槽的常驻输入张量
+    auto preprocessStart = std::chrono::high_resolution_clock::now();
+    resizeSlot(slot, 1, frame.size());
+    prepareInput(slot, frame, 0);
+    slot.preprocessMs = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - preprocessStart).count();
+    slot.frame = frame;
+    slot.detectColor = detectColor;
+    slot.frameIndex = frameIndex;
     
-    // 归一化
-    rgb.convertTo(rgb, CV_32F, 1.0 / 255.0);
+    // 启动异步推理
+    slot.request.start_async();
+}
+
+void Detector::finishSlot(InferSlot& slot, std::vector<DetectionResult>& results) {
+    // 等待推理完成
+    auto waitStart = std::chrono::high_resolution_clock::now();
+    {
+        TraceZone zone("Detector::infer", slot.frameIndex);
+        slot.request.wait();
+    }
+    auto waitEnd = std::chrono::high_resolution_clock::now();
+    accumulateLayerProfiles(slot.request);
     
-    // 分离通道并重新排列为NCHW格式
-    std::vector<cv::Mat> channels(3);
-    cv::split(rgb, channels);
+    // 后处理结果
+    postprocessResults(slot.outputTensor.data<float>(), slot.detectColor, results);
     
-    std::vector<float> inputTensor(3 * inputSize_.height * inputSize_.width);
-    for (int c = 0; c < 3; ++c) {
-        memcpy(inputTensor.data() + c * inputSize_.height * inputSize_.width, 
-               channels[c].data, 
-               inputSize_.height * inputSize_.width * sizeof(float));
+    lastTiming_.preprocessMs = slot.preprocessMs;
+    lastTiming_.inferMs = std::chrono::duration<double, std::milli>(waitEnd - waitStart).count();
+    lastTiming_.postprocessMs = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - waitEnd).count();
+}
+
+void Detector::prepareInput(InferSlot& slot, const cv::Mat& frame, int batchIndex) {
+    TraceZone zone("Detector::preprocess");
+    if (options_.useModelPreprocess) {
+        // 拷贝u8数据到输入张量（同时处理内存不连续的帧）
+        size_t frameBytes = static_cast<size_t>(frame.rows) * frame.cols * 3;
+        cv::Mat input(frame.rows, frame.cols, CV_8UC3, slot.inputTensor.data<uint8_t>() + batchIndex * frameBytes);
+        frame.copyTo(input);
+        return;
     }
     
-    return inputTensor;
+    // 预处理图像，直接写入输入张量
+    size_t planeSize = static_cast<size_t>(inputSize_.height) * inputSize_.width;
+    preprocessImage(frame, slot.inputTensor.data<float>() + batchIndex * 3 * planeSize);
 }
 
-std::vector<DetectionResult> Detector::postprocessResults(const float* outputData, 
-                                                         const std::vector<int>& outputShape,
-                                                         int detectColor) {
-    std::vector<DetectionResult> results;
+void Detector::preprocessImage(const cv::Mat& frame, float* inputData) {
+    // 缩放、BGR转RGB、归一化和HWC转CHW在一次遍历中完成，直接写入NCHW格式的输入张量
+    fusedPreprocessor_.process(frame, inputSize_, inputData);
+}
+
+void Detector::postprocessResults(const float* outputData, int detectColor,
+                                  std::vector<DetectionResult>& results) {
+    TraceZone zone("Detector::postprocess");
+    
+    // 清空但保留容量，稳态下不再分配
+    results.clear();
     
-    int numBoxes = outputShape[1];   // 检测框数量
-    int numAttrs = outputShape[2];   // 每个检测框的属性数量
+    // 先只扫描置信度列，完整解码仅在候选行上进行
+    int numCandidates = selectCandidates(outputData);
     
-    for (int i = 0; i < numBoxes; ++i) {
-        float* det = const_cast<float*>(outputData) + i * numAttrs;
+    for (int n = 0; n < numCandidates; ++n) {
+        const float* det = outputData + candidateRows_[n] * numAttrs_;
         
         // 计算置信度
         float confidence = sigmoid(det[8]);
-        if (confidence < 0.45f) continue;
         
         // 颜色分类
         int colorId = std::max_element(det + 8, det + 14) - (det + 8);
@@ -110,34 +457,52 @@ std::vector<DetectionResult> Detector::postprocessResults(const float* outputDat
             continue;
         }
         
+        // 直接在输出容器中构造检测结果
+        results.emplace_back();
+        DetectionResult& result = results.back();
+        
         // 提取关键点
-        std::vector<cv::Point2f> landmarks;
         for (int j = 0; j < 4; ++j) {
-            landmarks.emplace_back(det[j * 2], det[j * 2 + 1]);
+            result.landmarks[j] = cv::Point2f(det[j * 2], det[j * 2 + 1]);
         }
         
-        if (landmarks.size() != 4) continue;
-        
         // 计算边界框
-        cv::Rect boundingBox = computeBoundingBox(landmarks);
-        
-        // 创建检测结果
-        DetectionResult result;
-        result.boundingBox = boundingBox;
+        result.boundingBox = computeBoundingBox(result.landmarks);
         result.confidence = confidence;
         result.classId = classId;
         result.colorId = colorId;
-        result.landmarks = landmarks;
-        
-        results.push_back(result);
     }
-    
-    return results;
 }
 
-cv::Rect Detector::computeBoundingBox(const std::vector<cv::Point2f>& points) {
-    if (points.empty()) return cv::Rect();
+int Detector::selectCandidates(const float* outputData) {
+    const float* column = outputData + 8;          // 置信度位于每行第8列
+    const int stride = numAttrs_;
+    int* rows = candidateRows_.data();
+    int count = 0;
+    int i = 0;
+    
+#if defined(DETECTOR_USE_AVX2)
+    // 运行时确认CPU支持AVX2后才进入gather路径
+    if (CpuFeatures::hasAVX2()) {
+        i = scanLogitsAVX2(column, stride, numBoxes_, logitThreshold_, rows, count);
+    }
+#endif
+#if defined(DETECTOR_USE_SSE2)
+    // 未经AVX2扫描时用SSE2（x64基线指令集）
+    if (i == 0) {
+        i = scanLogitsSSE2(column, stride, numBoxes_, logitThreshold_, rows, count);
+    }
+#endif
     
+    // 标量处理剩余行（无SIMD时处理全部行）
+    for (; i < numBoxes_; ++i) {
+        if (column[i * stride] >= logitThreshold_) rows[count++] = i;
+    }
+    
+    return count;
+}
+
+cv::Rect Detector::computeBoundingBox(const std::array<cv::Point2f, 4>& points) {
     float minX = points[0].x, maxX = points[0].x;
     float minY = points[0].y, maxY = points[0].y;
     
@@ -153,4 +518,88 @@ cv::Rect Detector::computeBoundingBox(const std::vector<cv::Point2f>& points) {
 
 cv::Size Detector::getInputSize() const {
     return inputSize_;
+}
+
+int Detector::getPipelineDepth() const {
+    return static_cast<int>(slots_.size());
+}
+
+int Detector::getBatchSize() const {
+    return std::max(1, options_.batchSize);
+}
+
+double Detector::warmup(int iterations, const cv::Size& frameSize) {
+    if (pendingCount_ > 0) {
+        throw std::logic_error("Cannot warm up while pipelined frames are in flight");
+    }
+    auto warmupStart = std::chrono::high_resolution_clock::now();
+    
+    // 首次推理会触发内存分配和内核选择，用空白帧在每个推理请求上走完整检测流程
+    cv::Mat blank = cv::Mat::zeros(frameSize, CV_8UC3);
+    std::vector<DetectionResult> results;
+    for (int i = 0; i < iterations; ++i) {
+        for (auto& slot : slots_) {
+            startSlot(slot, blank, 1, -1);
+            finishSlot(slot, results);
+            slot.frame.release();
+        }
+    }
+    
+    auto warmupEnd = std::chrono::high_resolution_clock::now();
+    warmupTimeMs_ = std::chrono::duration<double, std::milli>(warmupEnd - warmupStart).count();
+    
+    // 预热帧不计入逐层耗时
+    resetLayerProfiles();
+    
+    std::cout << "Warm-up finished: " << iterations << " iterations x " << slots_.size() 
+              << " requests in " << warmupTimeMs_ << " ms" << std::endl;
+    return warmupTimeMs_;
+}
+
+double Detector::getLoadTime() const {
+    return loadTimeMs_;
+}
+
+double Detector::getWarmupTime() const {
+    return warmupTimeMs_;
+}
+
+const DetectorTiming& Detector::getLastTiming() const {
+    return lastTiming_;
+}
+
+bool Detector::isProfilingEnabled() const {
+    return options_.enableProfiling;
+}
+
+const std::vector<LayerProfile>& Detector::getLayerProfiles() const {
+    return layerProfiles_;
+}
+
+void Detector::resetLayerProfiles() {
+    layerProfiles_.clear();
+    layerIndex_.clear();
+}
+
+void Detector::accumulateLayerProfiles(const ov::InferRequest& request) {
+    if (!options_.enableProfiling) return;
+    
+    for (const ov::ProfilingInfo& info : request.get_profiling_info()) {
+        // 被融合或未执行的节点耗时为0，不计入
+        if (info.status != ov::ProfilingInfo::Status::EXECUTED) continue;
+        
+        auto found = layerIndex_.find(info.node_name);
+        if (found == layerIndex_.end()) {
+            found = layerIndex_.emplace(info.node_name, layerProfiles_.size()).first;
+            LayerProfile layer;
+            layer.name = info.node_name;
+            layer.nodeType = info.node_type;
+            layer.execType = info.exec_type;
+            layerProfiles_.push_back(layer);
+        }
+        LayerProfile& layer = layerProfiles_[found->second];
+        layer.count++;
+        layer.realTimeMs += info.real_time.count() / 1000.0;
+        layer.cpuTimeMs += info.cpu_time.count() / 1000.0;
+    }
 } 
\ No newline at end of file
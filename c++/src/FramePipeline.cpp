@@ -0,0 +1,276 @@
+#include "../include/FramePipeline.h"
+#include "../include/ThreadAffinity.h"
+#include "../include/TraceRecorder.h"
+#include "../ncnn/cpp/include/STrack.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+
+const char* kStageNames[] = {"capture", "infer", "track", "display"};
+
+long long elapsedNs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 等待队列时先让出时间片，较长时间等待改为短暂休眠，避免与推理线程争抢CPU
+void backoff(int& spins) {
+    if (++spins < 64) {
+        std::this_thread::yield();
+    } else {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+}
+
+} // namespace
+
+FramePipeline::FramePipeline(size_t queueCapacity)
+    : captureQueue_(queueCapacity), inferQueue_(queueCapacity), trackQueue_(queueCapacity) {
+}
+
+FramePipeline::~FramePipeline() {
+    stop();
+}
+
+void FramePipeline::setCaptureStage(CaptureFunc capture) {
+    capture_ = std::move(capture);
+}
+
+void FramePipeline::setInferStage(StageFunc infer) {
+    infer_ = std::move(infer);
+}
+
+void FramePipeline::setTrackStage(StageFunc track) {
+    track_ = std::move(track);
+}
+
+void FramePipeline::setLatestOnly(bool enable) {
+    latestOnly_ = enable;
+}
+
+void FramePipeline::setStageCores(const std::vector<int>& captureCores, const std::vector<int>& inferCores,
+                                  const std::vector<int>& trackCores, const std::vector<int>& displayCores) {
+    stageCores_[CaptureStage] = captureCores;
+    stageCores_[InferStage] = inferCores;
+    stageCores_[TrackStage] = trackCores;
+    stageCores_[DisplayStage] = displayCores;
+}
+
+void FramePipeline::setupStageThread(Stage stage) {
+    TraceRecorder::setThreadName(kStageNames[stage]);
+    if (!ThreadAffinity::pinCurrentThread(stageCores_[stage])) {
+        std::cerr << "Cannot pin " << kStageNames[stage] << " thread to cores "
+                  << ThreadAffinity::formatCoreList(stageCores_[stage]) << std::endl;
+    }
+}
+
+void FramePipeline::run(const DisplayFunc& display) {
+    if (!capture_ || !infer_ || !track_) {
+        throw std::runtime_error("FramePipeline stages are not fully configured");
+    }
+
+    stopRequested_ = false;
+    threads_.emplace_back(&FramePipeline::captureLoop, this);
+    threads_.emplace_back(&FramePipeline::workerLoop, this, InferStage,
+                          std::ref(captureQueue_), std::ref(inferQueue_), std::cref(infer_));
+    threads_.emplace_back(&FramePipeline::workerLoop, this, TrackStage,
+                          std::ref(inferQueue_), std::ref(trackQueue_), std::cref(track_));
+
+    // 显示阶段在当前线程执行；工作线程已启动，绑核不会被它们继承
+    setupStageThread(DisplayStage);
+    StageCounters& counters = counters_[DisplayStage];
+    FramePacket packet;
+    while (popPacket(trackQueue_, packet, counters)) {
+        if (packet.endOfStream) break;
+
+        auto start = std::chrono::steady_clock::now();
+        TraceZone zone(kStageNames[DisplayStage], packet.sequence);
+        bool keepRunning = display(packet);
+        zone.end();
+        counters.busyNs += elapsedNs(start);
+        counters.processedFrames++;
+        if (!keepRunning) break;
+    }
+
+    stop();
+    if (error_) {
+        std::rethrow_exception(error_);
+    }
+}
+
+void FramePipeline::stop() {
+    stopRequested_ = true;
+    for (auto& thread : threads_) {
+        if (thread.joinable()) thread.join();
+    }
+    threads_.clear();
+}
+
+void FramePipeline::captureLoop() {
+    StageCounters& counters = counters_[CaptureStage];
+    long long sequence = 0;
+    setupStageThread(CaptureStage);
+
+    try {
+        while (!stopRequested_) {
+            FramePacket packet;
+            auto start = std::chrono::steady_clock::now();
+            TraceZone zone(kStageNames[CaptureStage], sequence);
+            bool hasFrame = capture_(packet);
+            zone.end();
+            counters.busyNs += elapsedNs(start);
+
+            if (!hasFrame) {
+                // 输入结束标记沿流水线传递，各阶段处理完已有的帧后依次退出
+                packet.endOfStream = true;
+                pushPacket(captureQueue_, packet, counters);
+                return;
+            }
+
+            packet.sequence = sequence++;
+            if (packet.captureTime == std::chrono::steady_clock::time_point()) {
+                packet.captureTime = std::chrono::steady_clock::now();
+            }
+            counters.processedFrames++;
+            if (!pushPacket(captureQueue_, packet, counters)) return;
+        }
+    }
+    catch (...) {
+        recordError();
+    }
+}
+
+void FramePipeline::workerLoop(Stage stage, PacketQueue& input, PacketQueue& output, const StageFunc& func) {
+    StageCounters& counters = counters_[stage];
+    const bool latestOnly = latestOnly_ && stage == InferStage;
+    FramePacket packet;
+    FramePacket newer;
+    setupStageThread(stage);
+
+    try {
+        while (popPacket(input, packet, counters)) {
+            // 跳过积压的旧帧，只处理最新的一帧；遇到结束标记时先处理当前帧再转发
+            bool pendingEnd = false;
+            while (latestOnly && !packet.endOfStream && input.tryPop(newer)) {
+                if (newer.endOfStream) {
+                    pendingEnd = true;
+                    break;
+                }
+                packet = std::move(newer);
+                counters.droppedFrames++;
+            }
+
+            if (!packet.endOfStream) {
+                auto start = std::chrono::steady_clock::now();
+                TraceZone zone(kStageNames[stage], packet.sequence);
+                func(packet);
+                zone.end();
+                counters.busyNs += elapsedNs(start);
+                counters.processedFrames++;
+            }
+
+            bool endOfStream = packet.endOfStream;
+            if (!pushPacket(output, packet, counters) || endOfStream) return;
+            if (pendingEnd) {
+                pushPacket(output, newer, counters);
+                return;
+            }
+        }
+    }
+    catch (...) {
+        recordError();
+    }
+}
+
+bool FramePipeline::pushPacket(PacketQueue& queue, FramePacket& packet, StageCounters& counters) {
+    if (!queue.tryPush(std::move(packet))) {
+        auto start = std::chrono::steady_clock::now();
+        int spins = 0;
+        while (!queue.tryPush(std::move(packet))) {
+            if (stopRequested_) return false;
+            backoff(spins);
+        }
+        counters.outputStallNs += elapsedNs(start);
+    }
+
+    // 只有本阶段写入最大深度，无需CAS
+    size_t depth = queue.size();
+    if (depth > counters.maxQueueDepth.load(std::memory_order_relaxed)) {
+        counters.maxQueueDepth.store(depth, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+bool FramePipeline::popPacket(PacketQueue& queue, FramePacket& packet, StageCounters& counters) {
+    if (queue.tryPop(packet)) return true;
+
+    auto start = std::chrono::steady_clock::now();
+    int spins = 0;
+    while (!queue.tryPop(packet)) {
+        if (stopRequested_) return false;
+        backoff(spins);
+    }
+    counters.inputWaitNs += elapsedNs(start);
+    return true;
+}
+
+void FramePipeline::recordError() {
+    {
+        std::lock_guard<std::mutex> lock(errorMutex_);
+        if (!error_) error_ = std::current_exception();
+    }
+    stopRequested_ = true;
+}
+
+std::vector<PipelineStageStats> FramePipeline::getStageStats() const {
+    const PacketQueue* outputs[StageCount] = {&captureQueue_, &inferQueue_, &trackQueue_, nullptr};
+    std::vector<PipelineStageStats> stats(StageCount);
+
+    for (int i = 0; i < StageCount; ++i) {
+        const StageCounters& counters = counters_[i];
+        PipelineStageStats& stage = stats[i];
+        stage.name = kStageNames[i];
+        stage.processedFrames = counters.processedFrames.load();
+        stage.busyMs = counters.busyNs.load() / 1e6;
+        stage.inputWaitMs = counters.inputWaitNs.load() / 1e6;
+        stage.outputStallMs = counters.outputStallNs.load() / 1e6;
+        stage.maxQueueDepth = counters.maxQueueDepth.load();
+        stage.droppedFrames = counters.droppedFrames.load();
+        if (outputs[i]) {
+            stage.queueDepth = outputs[i]->size();
+            stage.queueCapacity = outputs[i]->capacity();
+        }
+    }
+    return stats;
+}
+
+void FramePipeline::printStatistics() const {
+    std::cout << "\n=== Pipeline Stage Statistics ===" << std::endl;
+    std::cout << std::left << std::setw(10) << "Stage"
+              << std::right << std::setw(10) << "Frames"
+              << std::setw(12) << "Busy ms/f"
+              << std::setw(12) << "Wait ms/f"
+              << std::setw(13) << "Stall ms/f"
+              << std::setw(12) << "Max queue"
+              << std::setw(10) << "Dropped" << std::endl;
+
+    for (const auto& stage : getStageStats()) {
+        double frames = static_cast<double>(std::max(1LL, stage.processedFrames));
+        std::cout << std::left << std::setw(10) << stage.name << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(10) << stage.processedFrames
+                  << std::setw(12) << stage.busyMs / frames
+                  << std::setw(12) << stage.inputWaitMs / frames
+                  << std::setw(13) << stage.outputStallMs / frames;
+        if (stage.queueCapacity > 0) {
+            std::cout << std::setw(9) << stage.maxQueueDepth << "/" << std::left << std::setw(2) << stage.queueCapacity
+                      << std::right;
+        } else {
+            std::cout << std::setw(12) << "-";
+        }
+        std::cout << std::setw(10) << stage.droppedFrames << std::endl;
+    }
+    std::cout << "The slowest stage has the highest busy time; stages ahead of it stall, stages behind it wait." << std::endl;
+    std::cout << "==================================" << std::endl;
+}
@@ -0,0 +1,152 @@
+#include "../include/FramePool.h"
+#include <iostream>
+#include <new>
+
+FramePool::FramePool(size_t maxCachedBuffers)
+    : maxCachedBuffers_(maxCachedBuffers) {
+    freeBuffers_.reserve(maxCachedBuffers_);
+    freeHeaders_.reserve(maxCachedBuffers_ * 2);
+}
+
+FramePool::~FramePool() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& buffer : freeBuffers_) {
+        cv::fastFree(buffer.second);
+    }
+    freeBuffers_.clear();
+    for (void* header : freeHeaders_) {
+        ::operator delete(header);
+    }
+    freeHeaders_.clear();
+}
+
+void FramePool::attach(cv::Mat& mat) {
+    mat.release();
+    if (isEnabled()) {
+        mat.allocator = this;
+    }
+}
+
+cv::Mat FramePool::acquire(const cv::Size& size, int type) {
+    cv::Mat mat;
+    attach(mat);
+    mat.create(size, type);
+    return mat;
+}
+
+bool FramePool::isEnabled() const {
+    return maxCachedBuffers_ > 0;
+}
+
+long long FramePool::getAllocatedBuffers() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return allocatedBuffers_;
+}
+
+long long FramePool::getReusedBuffers() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return reusedBuffers_;
+}
+
+void FramePool::printStatistics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    long long requests = allocatedBuffers_ + reusedBuffers_;
+    std::cout << "\n=== Frame Pool Statistics ===" << std::endl;
+    std::cout << "Buffer requests: " << requests << std::endl;
+    std::cout << "New allocations: " << allocatedBuffers_ << std::endl;
+    std::cout << "Reused: " << reusedBuffers_;
+    if (requests > 0) {
+        std::cout << " (" << 100.0 * reusedBuffers_ / requests << "%)";
+    }
+    std::cout << std::endl;
+    std::cout << "Cached / in use: " << freeBuffers_.size() << " / " << outstandingBuffers_ << std::endl;
+    std::cout << "==================================" << std::endl;
+}
+
+cv::UMatData* FramePool::allocate(int dims, const int* sizes, int type, void* data, size_t* step,
+                                  cv::AccessFlag /*flags*/, cv::UMatUsageFlags /*usageFlags*/) const {
+    // 与OpenCV默认分配器相同的步长计算
+    size_t total = CV_ELEM_SIZE(type);
+    for (int i = dims - 1; i >= 0; --i) {
+        if (step) {
+            if (data && step[i] != CV_AUTOSTEP) {
+                CV_Assert(total <= step[i]);
+                total = step[i];
+            } else {
+                step[i] = total;
+            }
+        }
+        total *= sizes[i];
+    }
+
+    // 优先在回收的UMatData头内存上重新构造
+    void* header = nullptr;
+    uchar* buffer = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!freeHeaders_.empty()) {
+            header = freeHeaders_.back();
+            freeHeaders_.pop_back();
+        }
+    }
+    cv::UMatData* u = header ? new (header) cv::UMatData(this) : new cv::UMatData(this);
+    u->size = total;
+
+    // 外部数据只包装，不进入池
+    if (data) {
+        u->data = u->origdata = static_cast<uchar*>(data);
+        u->flags |= cv::UMatData::USER_ALLOCATED;
+        return u;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t i = 0; i < freeBuffers_.size(); ++i) {
+            if (freeBuffers_[i].first == total) {
+                buffer = freeBuffers_[i].second;
+                freeBuffers_[i] = freeBuffers_.back();
+                freeBuffers_.pop_back();
+                reusedBuffers_++;
+                break;
+            }
+        }
+        if (!buffer) allocatedBuffers_++;
+        outstandingBuffers_++;
+    }
+    if (!buffer) {
+        buffer = static_cast<uchar*>(cv::fastMalloc(total));
+    }
+
+    u->data = u->origdata = buffer;
+    return u;
+}
+
+bool FramePool::allocate(cv::UMatData* data, cv::AccessFlag /*accessFlags*/, cv::UMatUsageFlags /*usageFlags*/) const {
+    return data != nullptr;
+}
+
+void FramePool::deallocate(cv::UMatData* u) const {
+    if (!u) return;
+    CV_Assert(u->urefcount == 0 && u->refcount == 0);
+
+    if (!(u->flags & cv::UMatData::USER_ALLOCATED)) {
+        bool cached = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            outstandingBuffers_--;
+            if (freeBuffers_.size() < maxCachedBuffers_) {
+                freeBuffers_.emplace_back(u->size, u->origdata);
+                cached = true;
+            }
+        }
+        if (!cached) {
+            cv::fastFree(u->origdata);
+        }
+        u->origdata = nullptr;
+    }
+
+    // 析构后保留头的内存供下次allocate复用，数量不超过同时在用的峰值
+    u->~UMatData();
+    std::lock_guard<std::mutex> lock(mutex_);
+    freeHeaders_.push_back(u);
+}
@@ -0,0 +1,206 @@
+#include "../include/FusedPreprocessor.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include "../include/CpuFeatures.h"
+
+#if defined(DETECTION_HAS_AVX2_KERNELS)
+#include <immintrin.h>
+#define FUSED_PREPROCESS_USE_AVX2
+#endif
+
+namespace {
+
+// 按输出行切分的并行任务
+class FusedPreprocessBody : public cv::ParallelLoopBody {
+public:
+    FusedPreprocessBody(const FusedPreprocessor::SampleTables& tables, const cv::Mat& src, float* output, float scale)
+        : tables_(tables), src_(src), output_(output), scale_(scale) {
+    }
+
+    void operator()(const cv::Range& range) const override {
+        FusedPreprocessor::processRows(tables_, src_, output_, scale_, range.start, range.end);
+    }
+
+private:
+    const FusedPreprocessor::SampleTables& tables_;
+    const cv::Mat& src_;
+    float* output_;
+    float scale_;
+};
+
+// 计算一个维度上的双线性采样位置，与cv::resize(INTER_LINEAR)的像素中心对齐方式一致
+void computeSamples(int srcLength, int dstLength, std::vector<int>& index0, std::vector<int>& index1,
+                    std::vector<float>& weights) {
+    index0.resize(dstLength);
+    index1.resize(dstLength);
+    weights.resize(dstLength);
+
+    double scale = static_cast<double>(srcLength) / dstLength;
+    for (int d = 0; d < dstLength; ++d) {
+        double f = (d + 0.5) * scale - 0.5;
+        int s = static_cast<int>(std::floor(f));
+        f -= s;
+        if (s < 0) {
+            f = 0;
+            s = 0;
+        }
+        if (s >= srcLength - 1) {
+            f = 0;
+            s = srcLength - 1;
+        }
+        index0[d] = s;
+        index1[d] = std::min(s + 1, srcLength - 1);
+        weights[d] = static_cast<float>(f);
+    }
+}
+
+#if defined(FUSED_PREPROCESS_USE_AVX2)
+// 从按4字节收集的BGR像素中取出一个通道并转为浮点
+DETECTION_TARGET_AVX2
+inline __m256 extractChannel(__m256i pixels, int channel) {
+    __m256i shifted = _mm256_srl_epi32(pixels, _mm_cvtsi32_si128(channel * 8));
+    return _mm256_cvtepi32_ps(_mm256_and_si256(shifted, _mm256_set1_epi32(0xFF)));
+}
+
+// 用AVX2处理一个输出行的前vectorEnd列（每次8列），返回已处理的列数
+DETECTION_TARGET_AVX2
+int processRowAVX2(const FusedPreprocessor::SampleTables& tables, const uint8_t* row0, const uint8_t* row1,
+                   float wy, float scale, float* outB, float* outG, float* outR) {
+    const __m256 vwy = _mm256_set1_ps(wy);
+    const __m256 vscale = _mm256_set1_ps(scale);
+    float* planes[3] = {outB, outG, outR};
+    int dx = 0;
+    for (; dx + 8 <= tables.vectorEnd; dx += 8) {
+        __m256i off0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tables.xOffsets0.data() + dx));
+        __m256i off1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tables.xOffsets1.data() + dx));
+        __m256 wx = _mm256_loadu_ps(tables.xWeights.data() + dx);
+
+        // 一次收集8个像素的4个邻点，每个32位元素的低3字节即B、G、R
+        __m256i p00 = _mm256_i32gather_epi32(reinterpret_cast<const int*>(row0), off0, 1);
+        __m256i p01 = _mm256_i32gather_epi32(reinterpret_cast<const int*>(row0), off1, 1);
+        __m256i p10 = _mm256_i32gather_epi32(reinterpret_cast<const int*>(row1), off0, 1);
+        __m256i p11 = _mm256_i32gather_epi32(reinterpret_cast<const int*>(row1), off1, 1);
+
+        for (int c = 0; c < 3; ++c) {
+            __m256 v00 = extractChannel(p00, c);
+            __m256 v01 = extractChannel(p01, c);
+            __m256 v10 = extractChannel(p10, c);
+            __m256 v11 = extractChannel(p11, c);
+            __m256 top = _mm256_fmadd_ps(_mm256_sub_ps(v01, v00), wx, v00);
+            __m256 bottom = _mm256_fmadd_ps(_mm256_sub_ps(v11, v10), wx, v10);
+            __m256 value = _mm256_fmadd_ps(_mm256_sub_ps(bottom, top), vwy, top);
+            _mm256_storeu_ps(planes[c] + dx, _mm256_mul_ps(value, vscale));
+        }
+    }
+    _mm256_zeroupper();
+    return dx;
+}
+#endif
+
+} // namespace
+
+void FusedPreprocessor::process(const cv::Mat& src, const cv::Size& dstSize, float* output, float scale) {
+    CV_Assert(src.type() == CV_8UC3 && !src.empty());
+
+    const SampleTables& tables = findTables(src.size(), dstSize);
+
+    // 按输出行并行，每个任务只写自己负责的行
+    cv::parallel_for_(cv::Range(0, dstSize.height), FusedPreprocessBody(tables, src, output, scale));
+}
+
+long long FusedPreprocessor::getTableBuilds() const {
+    return tableBuilds_;
+}
+
+const FusedPreprocessor::SampleTables& FusedPreprocessor::findTables(const cv::Size& srcSize, const cv::Size& dstSize) {
+    ++useCounter_;
+    for (auto& tables : tables_) {
+        if (tables.srcSize == srcSize && tables.dstSize == dstSize) {
+            tables.lastUse = useCounter_;
+            return tables;
+        }
+    }
+
+    // 未命中：缓存未满时新增一组，否则复用最久未用的一组（其向量容量可直接复用）
+    SampleTables* target = nullptr;
+    if (tables_.size() < kMaxCachedTables) {
+        tables_.emplace_back();
+        target = &tables_.back();
+    } else {
+        target = &*std::min_element(tables_.begin(), tables_.end(),
+                                    [](const SampleTables& a, const SampleTables& b) { return a.lastUse < b.lastUse; });
+    }
+    buildTables(srcSize, dstSize, *target);
+    target->lastUse = useCounter_;
+    tableBuilds_++;
+    return *target;
+}
+
+void FusedPreprocessor::buildTables(const cv::Size& srcSize, const cv::Size& dstSize, SampleTables& tables) {
+    computeSamples(srcSize.width, dstSize.width, tables.xOffsets0, tables.xOffsets1, tables.xWeights);
+    computeSamples(srcSize.height, dstSize.height, tables.yRows0, tables.yRows1, tables.yWeights);
+
+    // 列采样位置换算为字节偏移（3通道）
+    for (int dx = 0; dx < dstSize.width; ++dx) {
+        tables.xOffsets0[dx] *= 3;
+        tables.xOffsets1[dx] *= 3;
+    }
+
+    // 向量路径每次读取4字节，最后几列可能越过行尾，交给标量路径
+    const int rowBytes = srcSize.width * 3;
+    tables.vectorEnd = 0;
+    while (tables.vectorEnd < dstSize.width && tables.xOffsets1[tables.vectorEnd] + 4 <= rowBytes) {
+        tables.vectorEnd++;
+    }
+
+    tables.srcSize = srcSize;
+    tables.dstSize = dstSize;
+}
+
+void FusedPreprocessor::processRows(const SampleTables& tables, const cv::Mat& src, float* output, float scale,
+                                    int rowBegin, int rowEnd) {
+    const int width = tables.dstSize.width;
+    const size_t planeSize = static_cast<size_t>(tables.dstSize.width) * tables.dstSize.height;
+#if defined(FUSED_PREPROCESS_USE_AVX2)
+    const bool useAVX2 = CpuFeatures::hasAVX2();
+#endif
+
+    for (int dy = rowBegin; dy < rowEnd; ++dy) {
+        const uint8_t* row0 = src.ptr<uint8_t>(tables.yRows0[dy]);
+        const uint8_t* row1 = src.ptr<uint8_t>(tables.yRows1[dy]);
+        const float wy = tables.yWeights[dy];
+
+        // 输出平面按RGB顺序，源像素按BGR顺序
+        float* outR = output + dy * static_cast<size_t>(width);
+        float* outG = outR + planeSize;
+        float* outB = outG + planeSize;
+        int dx = 0;
+
+#if defined(FUSED_PREPROCESS_USE_AVX2)
+        // 运行时确认CPU支持AVX2后才进入gather路径
+        if (useAVX2) {
+            dx = processRowAVX2(tables, row0, row1, wy, scale, outB, outG, outR);
+        }
+#endif
+
+        // 标量路径（未使用AVX2时处理整行）
+        for (; dx < width; ++dx) {
+            const uint8_t* p00 = row0 + tables.xOffsets0[dx];
+            const uint8_t* p01 = row0 + tables.xOffsets1[dx];
+            const uint8_t* p10 = row1 + tables.xOffsets0[dx];
+            const uint8_t* p11 = row1 + tables.xOffsets1[dx];
+            const float wx = tables.xWeights[dx];
+
+            float values[3];
+            for (int c = 0; c < 3; ++c) {
+                float top = p00[c] + (p01[c] - p00[c]) * wx;
+                float bottom = p10[c] + (p11[c] - p10[c]) * wx;
+                values[c] = (top + (bottom - top) * wy) * scale;
+            }
+            outB[dx] = values[0];
+            outG[dx] = values[1];
+            outR[dx] = values[2];
+        }
+    }
+}
\ No newline at end of file
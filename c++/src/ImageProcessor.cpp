@@ -1,5 +1,97 @@
 #include "../include/ImageProcessor.h"
+#include "../include/TraceRecorder.h"
+#include "../ncnn/cpp/include/STrack.h"
 #include <opencv2/dnn.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// 叉积 (b - a) x (c - a)
+inline float cross(const cv::Point2f& a, const cv::Point2f& b, const cv::Point2f& c) {
+    return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+// 多边形面积（顶点按正方向排列时为正）
+inline float polygonArea(const cv::Point2f* points, int count) {
+    float area = 0.0f;
+    for (int i = 0, j = count - 1; i < count; j = i++) {
+        area += points[j].x * points[i].y - points[i].x * points[j].y;
+    }
+    return area * 0.5f;
+}
+
+// 四个点的凸包（单调链），结果按正方向排列，返回顶点数
+int convexHull4(const std::array<cv::Point2f, 4>& input, cv::Point2f* hull) {
+    cv::Point2f points[4] = {input[0], input[1], input[2], input[3]};
+    std::sort(points, points + 4, [](const cv::Point2f& a, const cv::Point2f& b) {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    });
+    
+    cv::Point2f chain[8];
+    int k = 0;
+    for (int i = 0; i < 4; ++i) {
+        while (k >= 2 && cross(chain[k - 2], chain[k - 1], points[i]) <= 0) k--;
+        chain[k++] = points[i];
+    }
+    for (int i = 2, lower = k + 1; i >= 0; --i) {
+        while (k >= lower && cross(chain[k - 2], chain[k - 1], points[i]) <= 0) k--;
+        chain[k++] = points[i];
+    }
+    
+    // 最后一个点与起点重复
+    int count = std::max(k - 1, 0);
+    std::copy(chain, chain + count, hull);
+    return count;
+}
+
+// 两个凸多边形的交集面积（Sutherland-Hodgman裁剪）
+float convexIntersectionArea(const cv::Point2f* subject, int subjectCount,
+                             const cv::Point2f* clip, int clipCount) {
+    cv::Point2f bufferA[8], bufferB[8];
+    cv::Point2f* current = bufferA;
+    cv::Point2f* next = bufferB;
+    int count = subjectCount;
+    std::copy(subject, subject + subjectCount, current);
+    
+    for (int e = 0; e < clipCount && count > 0; ++e) {
+        const cv::Point2f& a = clip[e];
+        const cv::Point2f& b = clip[(e + 1) % clipCount];
+        int nextCount = 0;
+        
+        for (int i = 0; i < count; ++i) {
+            const cv::Point2f& p = current[i];
+            const cv::Point2f& q = current[(i + 1) % count];
+            float sideP = cross(a, b, p);
+            float sideQ = cross(a, b, q);
+            
+            if (sideP >= 0) next[nextCount++] = p;
+            if ((sideP >= 0) != (sideQ >= 0)) {
+                float t = sideP / (sideP - sideQ);
+                next[nextCount++] = p + (q - p) * t;
+            }
+        }
+        std::swap(current, next);
+        count = nextCount;
+    }
+    
+    return count >= 3 ? polygonArea(current, count) : 0.0f;
+}
+
+// 关键点的外接框（与Detector::computeBoundingBox一致）
+cv::Rect landmarkBoundingBox(const std::array<cv::Point2f, 4>& points) {
+    float minX = points[0].x, maxX = points[0].x;
+    float minY = points[0].y, maxY = points[0].y;
+    for (const auto& p : points) {
+        minX = std::min(minX, p.x);
+        maxX = std::max(maxX, p.x);
+        minY = std::min(minY, p.y);
+        maxY = std::max(maxY, p.y);
+    }
+    return cv::Rect(cv::Point2f(minX, minY), cv::Point2f(maxX, maxY));
+}
+
+} // namespace
 
 cv::Mat ImageProcessor::preprocessForInference(const cv::Mat& frame, const cv::Size& targetSize) {
     cv::Mat resized;
@@ -11,11 +103,141 @@ std::vector<int> ImageProcessor::applyNMS(const std::vector<cv::Rect>& boxes,
                                          const std::vector<float>& confidences,
                                          float confidenceThreshold,
                                          float nmsThreshold) {
+    TraceZone zone("ImageProcessor::applyNMS");
     std::vector<int> indices;
     cv::dnn::NMSBoxes(boxes, confidences, confidenceThreshold, nmsThreshold, indices);
     return indices;
 }
 
+void ImageProcessor::applyQuadNMS(const std::vector<DetectionResult>& detections,
+                                  float confidenceThreshold,
+                                  float nmsThreshold,
+                                  bool mergeLandmarks,
+                                  std::vector<DetectionResult>& output) {
+    TraceZone zone("ImageProcessor::applyQuadNMS");
+    output.clear();
+    
+    // 过滤低置信度候选并按置信度降序排序一次（同分时按原顺序）
+    nmsOrder_.clear();
+    for (int i = 0; i < static_cast<int>(detections.size()); ++i) {
+        if (detections[i].confidence >= confidenceThreshold) {
+            nmsOrder_.push_back(i);
+        }
+    }
+    std::sort(nmsOrder_.begin(), nmsOrder_.end(), [&detections](int a, int b) {
+        float ca = detections[a].confidence;
+        float cb = detections[b].confidence;
+        return ca > cb || (ca == cb && a < b);
+    });
+    
+    // 预先计算每个候选的凸包、面积和外接框
+    const size_t count = nmsOrder_.size();
+    nmsQuads_.resize(count);
+    nmsSuppressed_.assign(count, 0);
+    for (size_t i = 0; i < count; ++i) {
+        const DetectionResult& detection = detections[nmsOrder_[i]];
+        QuadCandidate& quad = nmsQuads_[i];
+        quad.numVertices = convexHull4(detection.landmarks, quad.vertices);
+        quad.area = quad.numVertices >= 3 ? polygonArea(quad.vertices, quad.numVertices) : 0.0f;
+        
+        // 关键点退化（重合或共线）时退回使用边界框
+        if (quad.area < 1.0f) {
+            const cv::Rect& box = detection.boundingBox;
+            quad.vertices[0] = cv::Point2f(static_cast<float>(box.x), static_cast<float>(box.y));
+            quad.vertices[1] = cv::Point2f(static_cast<float>(box.x), static_cast<float>(box.y + box.height));
+            quad.vertices[2] = cv::Point2f(static_cast<float>(box.x + box.width), static_cast<float>(box.y + box.height));
+            quad.vertices[3] = cv::Point2f(static_cast<float>(box.x + box.width), static_cast<float>(box.y));
+            quad.numVertices = 4;
+            quad.area = std::fabs(polygonArea(quad.vertices, 4));
+            if (polygonArea(quad.vertices, 4) < 0) std::reverse(quad.vertices, quad.vertices + 4);
+        }
+        
+        quad.minX = quad.maxX = quad.vertices[0].x;
+        quad.minY = quad.maxY = quad.vertices[0].y;
+        for (int v = 1; v < quad.numVertices; ++v) {
+            quad.minX = std::min(quad.minX, quad.vertices[v].x);
+            quad.maxX = std::max(quad.maxX, quad.vertices[v].x);
+            quad.minY = std::min(quad.minY, quad.vertices[v].y);
+            quad.maxY = std::max(quad.maxY, quad.vertices[v].y);
+        }
+    }
+    
+    for (size_t i = 0; i < count; ++i) {
+        if (nmsSuppressed_[i]) continue;
+        
+        const DetectionResult& kept = detections[nmsOrder_[i]];
+        const QuadCandidate& a = nmsQuads_[i];
+        
+        // 关键点加权合并的累加量，以保留目标自身为初值
+        std::array<cv::Point2f, 4> landmarkSum;
+        float weightSum = kept.confidence;
+        for (size_t k = 0; k < landmarkSum.size(); ++k) {
+            landmarkSum[k] = kept.landmarks[k] * kept.confidence;
+        }
+        
+        for (size_t j = i + 1; j < count; ++j) {
+            if (nmsSuppressed_[j]) continue;
+            
+            const DetectionResult& candidate = detections[nmsOrder_[j]];
+            if (candidate.classId != kept.classId || candidate.colorId != kept.colorId) continue;
+            
+            // 外接框快速排除：外接框交集面积是四边形交集面积的上界
+            const QuadCandidate& b = nmsQuads_[j];
+            float overlapW = std::min(a.maxX, b.maxX) - std::max(a.minX, b.minX);
+            float overlapH = std::min(a.maxY, b.maxY) - std::max(a.minY, b.minY);
+            if (overlapW <= 0 || overlapH <= 0) continue;
+            float upperBound = std::min(overlapW * overlapH, std::min(a.area, b.area));
+            if (upperBound <= nmsThreshold * (a.area + b.area - upperBound)) continue;
+            
+            float intersection = convexIntersectionArea(a.vertices, a.numVertices, b.vertices, b.numVertices);
+            float unionArea = a.area + b.area - intersection;
+            if (unionArea <= 0 || intersection <= nmsThreshold * unionArea) continue;
+            
+            nmsSuppressed_[j] = 1;
+            if (mergeLandmarks) {
+                weightSum += candidate.confidence;
+                for (size_t k = 0; k < landmarkSum.size(); ++k) {
+                    landmarkSum[k] += candidate.landmarks[k] * candidate.confidence;
+                }
+            }
+        }
+        
+        output.push_back(kept);
+        if (mergeLandmarks && weightSum > kept.confidence) {
+            DetectionResult& merged = output.back();
+            for (size_t k = 0; k < landmarkSum.size(); ++k) {
+                merged.landmarks[k] = landmarkSum[k] * (1.0f / weightSum);
+            }
+            merged.boundingBox = landmarkBoundingBox(merged.landmarks);
+        }
+    }
+}
+
+void ImageProcessor::applyNMSByMode(const std::vector<DetectionResult>& detections,
+                                    float confidenceThreshold,
+                                    float nmsThreshold,
+                                    const std::string& nmsMode,
+                                    bool mergeLandmarks,
+                                    std::vector<DetectionResult>& output) {
+    if (nmsMode != "BOX") {
+        applyQuadNMS(detections, confidenceThreshold, nmsThreshold, mergeLandmarks, output);
+        return;
+    }
+    
+    nmsBoxes_.clear();
+    nmsConfidences_.clear();
+    for (const auto& detection : detections) {
+        nmsBoxes_.push_back(detection.boundingBox);
+        nmsConfidences_.push_back(detection.confidence);
+    }
+    
+    std::vector<int> indices = applyNMS(nmsBoxes_, nmsConfidences_, confidenceThreshold, nmsThreshold);
+    output.clear();
+    for (int idx : indices) {
+        output.push_back(detections[idx]);
+    }
+}
+
 std::vector<DetectionResult> ImageProcessor::scaleResultsToOriginal(const std::vector<DetectionResult>& results,
                                                                    const cv::Size& originalSize,
                                                                    const cv::Size& processedSize) {
@@ -45,25 +267,88 @@ std::vector<DetectionResult> ImageProcessor::scaleResultsToOriginal(const std::v
     return scaledResults;
 }
 
-std::vector<float> ImageProcessor::convertToTensor(const cv::Mat& image) {
-    // 转换颜色空间
-    cv::Mat rgb;
-    cv::cvtColor(image, rgb, cv::COLOR_BGR2RGB);
+bool ImageProcessor::computeTrackROIs(const std::vector<STrack>& tracks,
+                                      const cv::Size& frameSize,
+                                      const cv::Size& inputSize,
+                                      float margin,
+                                      std::vector<cv::Rect>& rois) {
+    rois.clear();
+    
+    // 帧本身不大于模型输入时裁剪没有分辨率收益
+    if (frameSize.width <= inputSize.width || frameSize.height <= inputSize.height) {
+        return false;
+    }
     
-    // 归一化
-    rgb.convertTo(rgb, CV_32F, 1.0 / 255.0);
+    const cv::Rect frameRect(cv::Point(0, 0), frameSize);
+    for (const auto& track : tracks) {
+        if (track.state != TrackState::Tracked) continue;
+        
+        // 卡尔曼状态为(cx, cy, a, h, vx, vy, va, vh)，外推一帧得到预测位置
+        float cx = track.mean(0) + track.mean(4);
+        float cy = track.mean(1) + track.mean(5);
+        float h = track.mean(3) + track.mean(7);
+        float w = (track.mean(2) + track.mean(6)) * h;
+        
+        // 按margin扩展以容纳预测误差，扩展后装不进ROI说明目标较近，交给全图检测
+        float expandedW = w * (1.0f + 2.0f * margin);
+        float expandedH = h * (1.0f + 2.0f * margin);
+        if (expandedW > inputSize.width || expandedH > inputSize.height) {
+            return false;
+        }
+        cv::Rect expanded(cv::Point(cvRound(cx - expandedW / 2), cvRound(cy - expandedH / 2)),
+                          cv::Size(cvRound(expandedW), cvRound(expandedH)));
+        
+        // 已被某个ROI完整覆盖的目标不再单独裁剪
+        bool covered = false;
+        for (const auto& roi : rois) {
+            if ((roi & expanded) == expanded) {
+                covered = true;
+                break;
+            }
+        }
+        if (covered) continue;
+        
+        // 以预测中心为中心裁剪模型输入尺寸的窗口，越界时平移回帧内
+        cv::Rect roi(cvRound(cx) - inputSize.width / 2, cvRound(cy) - inputSize.height / 2,
+                     inputSize.width, inputSize.height);
+        roi.x = std::min(std::max(roi.x, 0), frameSize.width - roi.width);
+        roi.y = std::min(std::max(roi.y, 0), frameSize.height - roi.height);
+        rois.push_back(roi & frameRect);
+    }
     
-    // 分离通道
-    std::vector<cv::Mat> channels(3);
-    cv::split(rgb, channels);
+    return !rois.empty();
+}
+
+void ImageProcessor::mapROIResultsToFrame(const std::vector<DetectionResult>& results,
+                                          const cv::Rect& roi,
+                                          const cv::Size& inputSize,
+                                          std::vector<DetectionResult>& output) {
+    float scaleX = static_cast<float>(roi.width) / inputSize.width;
+    float scaleY = static_cast<float>(roi.height) / inputSize.height;
     
-    // 重新排列为NCHW格式
-    std::vector<float> tensor(3 * image.rows * image.cols);
-    for (int c = 0; c < 3; ++c) {
-        memcpy(tensor.data() + c * image.rows * image.cols, 
-               channels[c].data, 
-               image.rows * image.cols * sizeof(float));
+    for (const auto& result : results) {
+        DetectionResult mapped = result;
+        
+        // 映射边界框
+        mapped.boundingBox.x = static_cast<int>(result.boundingBox.x * scaleX) + roi.x;
+        mapped.boundingBox.y = static_cast<int>(result.boundingBox.y * scaleY) + roi.y;
+        mapped.boundingBox.width = static_cast<int>(result.boundingBox.width * scaleX);
+        mapped.boundingBox.height = static_cast<int>(result.boundingBox.height * scaleY);
+        
+        // 映射关键点
+        for (auto& landmark : mapped.landmarks) {
+            landmark.x = landmark.x * scaleX + roi.x;
+            landmark.y = landmark.y * scaleY + roi.y;
+        }
+        
+        output.push_back(mapped);
     }
+}
+
+std::vector<float> ImageProcessor::convertToTensor(const cv::Mat& image) {
+    // 颜色转换、归一化和NCHW重排在一次遍历中完成（尺寸不变）
+    std::vector<float> tensor(3 * image.rows * image.cols);
+    fusedPreprocessor_.process(image, image.size(), tensor.data());
     
     return tensor;
 } 
\ No newline at end of file
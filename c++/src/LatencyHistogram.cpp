@@ -0,0 +1,113 @@
+#include "../include/LatencyHistogram.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+int LatencyHistogram::bucketIndex(uint64_t micros) {
+    if (micros < 2 * kSubBucketCount) {
+        return static_cast<int>(micros);
+    }
+
+    // 保留最高的kSubBucketBits+1位，其余位数即所在区间
+    int shift = 0;
+    while ((micros >> shift) >= 2 * kSubBucketCount) {
+        ++shift;
+    }
+    if (shift > kMaxShift) {
+        return -1;
+    }
+    return shift * kSubBucketCount + static_cast<int>(micros >> shift);
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(int index) {
+    if (index < 2 * kSubBucketCount) {
+        return static_cast<uint64_t>(index);
+    }
+    int shift = index / kSubBucketCount - 1;
+    uint64_t subBucket = static_cast<uint64_t>(index - shift * kSubBucketCount);
+    return ((subBucket + 1) << shift) - 1;
+}
+
+double LatencyHistogram::getRangeMax() {
+    return (bucketUpperBound(kBucketCount - 1) + 1) / 1000.0;
+}
+
+void LatencyHistogram::record(double milliseconds) {
+    // 极大值（含inf）先截断，避免转换为整数时溢出；截断后仍超出分桶上限，计入溢出
+    double clampedMicros = std::min(milliseconds * 1000.0, 1e15);
+    uint64_t micros = milliseconds > 0.0 ? static_cast<uint64_t>(std::llround(clampedMicros)) : 0;
+
+    int index = bucketIndex(micros);
+    if (index >= 0) {
+        buckets_[index].fetch_add(1, std::memory_order_relaxed);
+    } else {
+        overflow_.fetch_add(1, std::memory_order_relaxed);
+    }
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sumMicros_.fetch_add(micros, std::memory_order_relaxed);
+
+    uint64_t current = minMicros_.load(std::memory_order_relaxed);
+    while (micros < current && !minMicros_.compare_exchange_weak(current, micros, std::memory_order_relaxed)) {
+    }
+    current = maxMicros_.load(std::memory_order_relaxed);
+    while (micros > current && !maxMicros_.compare_exchange_weak(current, micros, std::memory_order_relaxed)) {
+    }
+}
+
+long long LatencyHistogram::getCount() const {
+    return static_cast<long long>(count_.load(std::memory_order_relaxed));
+}
+
+long long LatencyHistogram::getOverflowCount() const {
+    return static_cast<long long>(overflow_.load(std::memory_order_relaxed));
+}
+
+double LatencyHistogram::getMean() const {
+    uint64_t count = count_.load(std::memory_order_relaxed);
+    return count > 0 ? sumMicros_.load(std::memory_order_relaxed) / 1000.0 / count : 0.0;
+}
+
+double LatencyHistogram::getMin() const {
+    return count_.load(std::memory_order_relaxed) > 0 ? minMicros_.load(std::memory_order_relaxed) / 1000.0 : 0.0;
+}
+
+double LatencyHistogram::getMax() const {
+    return maxMicros_.load(std::memory_order_relaxed) / 1000.0;
+}
+
+double LatencyHistogram::getPercentile(double percentile) const {
+    // 记录与读取并发时各桶计数之和可能与count_不一致，按各桶实际计数计算
+    uint64_t total = overflow_.load(std::memory_order_relaxed);
+    for (int i = 0; i < kBucketCount; ++i) {
+        total += buckets_[i].load(std::memory_order_relaxed);
+    }
+    if (total == 0) return 0.0;
+
+    double clamped = std::min(100.0, std::max(0.0, percentile));
+    uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(clamped / 100.0 * total)));
+    uint64_t cumulative = 0;
+    uint64_t maxMicros = maxMicros_.load(std::memory_order_relaxed);
+    for (int i = 0; i < kBucketCount; ++i) {
+        cumulative += buckets_[i].load(std::memory_order_relaxed);
+        if (cumulative >= target) {
+            return std::min(bucketUpperBound(i), maxMicros) / 1000.0;
+        }
+    }
+    // 目标落在溢出部分，各桶上界都不能代表它，返回实际最大值
+    return maxMicros / 1000.0;
+}
+
+void LatencyHistogram::reset() {
+    for (auto& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    overflow_.store(0, std::memory_order_relaxed);
+    count_.store(0, std::memory_order_relaxed);
+    sumMicros_.store(0, std::memory_order_relaxed);
+    minMicros_.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+    maxMicros_.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,146 @@
+#include "../include/LatestFrameGrabber.h"
+#include "../include/FramePool.h"
+#include "../include/ThreadAffinity.h"
+#include "../include/TraceRecorder.h"
+#include "../include/AllocationTracker.h"
+#include <iostream>
+
+LatestFrameGrabber::LatestFrameGrabber(cv::VideoCapture& capture, double paceFps, FramePool* framePool)
+    : capture_(capture), paceFps_(paceFps), framePool_(framePool) {
+}
+
+LatestFrameGrabber::~LatestFrameGrabber() {
+    stop();
+}
+
+void LatestFrameGrabber::setCores(const std::vector<int>& cores) {
+    cores_ = cores;
+}
+
+void LatestFrameGrabber::start() {
+    if (thread_.joinable()) return;
+    stopRequested_ = false;
+    thread_ = std::thread(&LatestFrameGrabber::grabLoop, this);
+}
+
+void LatestFrameGrabber::stop() {
+    stopRequested_ = true;
+    if (thread_.joinable()) thread_.join();
+}
+
+bool LatestFrameGrabber::read(cv::Mat& frame, std::chrono::steady_clock::time_point* grabTime) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    frameReady_.wait(lock, [this]() { return hasFrame_ || finished_; });
+
+    if (error_) {
+        std::rethrow_exception(error_);
+    }
+    if (!hasFrame_) return false;
+
+    frame = std::move(slot_);
+    if (grabTime) *grabTime = slotTime_;
+    hasFrame_ = false;
+    deliveredFrames_++;
+    return true;
+}
+
+bool LatestFrameGrabber::tryRead(cv::Mat& frame, std::chrono::steady_clock::time_point* grabTime) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (error_) {
+        std::rethrow_exception(error_);
+    }
+    if (!hasFrame_) return false;
+    
+    frame = std::move(slot_);
+    if (grabTime) *grabTime = slotTime_;
+    hasFrame_ = false;
+    deliveredFrames_++;
+    return true;
+}
+
+bool LatestFrameGrabber::isFinished() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return finished_ && !hasFrame_;
+}
+
+void LatestFrameGrabber::grabLoop() {
+    using Clock = std::chrono::steady_clock;
+    const bool paced = paceFps_ > 0.0;
+    const auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(
+        paced ? 1.0 / paceFps_ : 0.0));
+    auto nextGrab = Clock::now();
+    
+    TraceRecorder::setThreadName("grabber");
+    AllocationScope allocationScope(AllocationTracker::CaptureStage);
+    if (!ThreadAffinity::pinCurrentThread(cores_)) {
+        std::cerr << "Cannot pin capture thread to cores " << ThreadAffinity::formatCoreList(cores_) << std::endl;
+    }
+
+    try {
+        while (!stopRequested_) {
+            if (paced) {
+                std::this_thread::sleep_until(nextGrab);
+                nextGrab += period;
+                // 读取本身落后超过一个周期时重新对齐，避免追帧
+                if (nextGrab < Clock::now()) nextGrab = Clock::now() + period;
+            }
+
+            // 每帧读入新的Mat，已交付给消费者的帧不会被覆盖写入；
+            // 使用缓冲池时被覆盖丢弃的帧缓冲区直接回池，供下一次读取复用
+            cv::Mat frame;
+            if (framePool_) framePool_->attach(frame);
+            TraceZone readZone("LatestFrameGrabber::read");
+            if (!capture_.read(frame)) break;
+            readZone.end();
+            auto grabTime = Clock::now();
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (hasFrame_) droppedFrames_++;
+                slot_ = std::move(frame);
+                slotTime_ = grabTime;
+                hasFrame_ = true;
+                grabbedFrames_++;
+            }
+            frameReady_.notify_one();
+        }
+    }
+    catch (...) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        error_ = std::current_exception();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        finished_ = true;
+    }
+    frameReady_.notify_all();
+}
+
+long long LatestFrameGrabber::getGrabbedFrames() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return grabbedFrames_;
+}
+
+long long LatestFrameGrabber::getDeliveredFrames() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return deliveredFrames_;
+}
+
+long long LatestFrameGrabber::getDroppedFrames() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return droppedFrames_;
+}
+
+void LatestFrameGrabber::printStatistics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::cout << "\n=== Latest-Frame Capture Statistics ===" << std::endl;
+    std::cout << "Grabbed frames: " << grabbedFrames_ << std::endl;
+    std::cout << "Delivered frames: " << deliveredFrames_ << std::endl;
+    std::cout << "Dropped frames: " << droppedFrames_;
+    if (grabbedFrames_ > 0) {
+        std::cout << " (" << 100.0 * droppedFrames_ / grabbedFrames_ << "%)";
+    }
+    std::cout << std::endl;
+    std::cout << "==================================" << std::endl;
+}
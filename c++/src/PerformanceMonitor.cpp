@@ -1,8 +1,40 @@
 #include "../include/PerformanceMonitor.h"
+#include "../include/Detector.h"
+#include <algorithm>
+#include <fstream>
 #include <iomanip>
 
+namespace {
+const char* kStageNames[] = {"decode", "preprocess", "infer", "postprocess", "nms", "track", "render", "end-to-end"};
+
+// 按累计墙钟耗时降序排列的网络层
+std::vector<const LayerProfile*> sortLayersByTime(const std::vector<LayerProfile>& layers) {
+    std::vector<const LayerProfile*> sorted;
+    for (const auto& layer : layers) {
+        sorted.push_back(&layer);
+    }
+    std::stable_sort(sorted.begin(), sorted.end(), [](const LayerProfile* a, const LayerProfile* b) {
+        return a->realTimeMs > b->realTimeMs;
+    });
+    return sorted;
+}
+
+// 所有网络层的累计墙钟耗时（毫秒）
+double totalLayerTime(const std::vector<LayerProfile>& layers) {
+    double total = 0.0;
+    for (const auto& layer : layers) {
+        total += layer.realTimeMs;
+    }
+    return total;
+}
+} // namespace
+
 PerformanceMonitor::PerformanceMonitor() 
-    : totalFrames_(0), totalInferenceTime_(0.0), isRunning_(false) {
+    : totalFrames_(0), totalInferenceTime_(0.0), isRunning_(false),
+      startupTime_(0.0), warmupTime_(0.0), firstDetectionTime_(-1.0),
+      totalRenderTime_(0.0), renderFrames_(0), renderOverlapped_(false),
+      totalLatency_(0.0), maxLatency_(0.0), latencyFrames_(0),
+      missesByCulprit_(), overshootByCulprit_() {
 }
 
 void PerformanceMonitor::start() {
@@ -25,12 +57,115 @@ void PerformanceMonitor::incrementFrameCount() {
     totalFrames_++;
 }
 
-double PerformanceMonitor::getTotalTime() const {
-    if (!isRunning_) {
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime_ - startTime_);
-        return duration.count() / 1000.0;
+void PerformanceMonitor::recordStartupTime(double startupTime) {
+    startupTime_ = startupTime;
+}
+
+void PerformanceMonitor::recordWarmupTime(double warmupTime) {
+    warmupTime_ = warmupTime;
+}
+
+void PerformanceMonitor::recordFirstDetectionTime(double firstDetectionTime) {
+    if (firstDetectionTime_ < 0) {
+        firstDetectionTime_ = firstDetectionTime;
     }
-    return 0.0;
+}
+
+void PerformanceMonitor::recordRenderTime(double renderTime) {
+    totalRenderTime_ += renderTime;
+    renderFrames_++;
+    stageHistograms_[RenderStage].record(renderTime);
+}
+
+void PerformanceMonitor::setRenderOverlapped(bool overlapped) {
+    renderOverlapped_ = overlapped;
+}
+
+void PerformanceMonitor::recordLatency(double latency) {
+    totalLatency_ += latency;
+    if (latency > maxLatency_) maxLatency_ = latency;
+    latencyFrames_++;
+    stageHistograms_[EndToEndStage].record(latency);
+}
+
+void PerformanceMonitor::recordStageTime(Stage stage, double stageTime) {
+    stageHistograms_[stage].record(stageTime);
+}
+
+const LatencyHistogram& PerformanceMonitor::getStageHistogram(Stage stage) const {
+    return stageHistograms_[stage];
+}
+
+double PerformanceMonitor::getStagePercentile(Stage stage, double percentile) const {
+    return stageHistograms_[stage].getPercentile(percentile);
+}
+
+const char* PerformanceMonitor::getStageName(Stage stage) {
+    return kStageNames[stage];
+}
+
+double PerformanceMonitor::percentileOfSorted(const std::vector<double>& sorted, double percentile) {
+    if (sorted.empty()) return 0.0;
+    size_t index = static_cast<size_t>(percentile / 100.0 * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+void PerformanceMonitor::setFrameDeadline(double deadline) {
+    deadlineStats_.deadlineMs = deadline;
+}
+
+void PerformanceMonitor::recordFrameDeadline(double latency, const FrameStageTimes& stageTimes) {
+    if (deadlineStats_.deadlineMs <= 0) return;
+    
+    // 参与归因的阶段：解码在采集时间戳之前，绘制在出结果之后，都不计入延迟
+    static const Stage kBudgetStages[] = {PreprocessStage, InferStage, PostprocessStage, NMSStage, TrackStage};
+    double measured = 0.0;
+    for (Stage stage : kBudgetStages) {
+        measured += stageTimes[stage];
+    }
+    double wait = std::max(0.0, latency - measured);
+    waitHistogram_.record(wait);
+    
+    deadlineStats_.frames++;
+    deadlineStats_.lastMissed = latency > deadlineStats_.deadlineMs;
+    if (!deadlineStats_.lastMissed) {
+        deadlineStats_.currentStreak = 0;
+        return;
+    }
+    
+    double overshoot = latency - deadlineStats_.deadlineMs;
+    deadlineStats_.misses++;
+    deadlineStats_.currentStreak++;
+    deadlineStats_.longestStreak = std::max(deadlineStats_.longestStreak, deadlineStats_.currentStreak);
+    overshootHistogram_.record(overshoot);
+    
+    // 平时就占大部分预算的阶段（通常是推理）不一定是超时的原因，按比自身中位数多出的时间找出异常的阶段
+    int culprit = kWaitCulprit;
+    double maxExcess = wait - waitHistogram_.getPercentile(50);
+    for (Stage stage : kBudgetStages) {
+        double excess = stageTimes[stage] - stageHistograms_[stage].getPercentile(50);
+        if (excess > maxExcess) {
+            maxExcess = excess;
+            culprit = stage;
+        }
+    }
+    missesByCulprit_[culprit]++;
+    overshootByCulprit_[culprit] += overshoot;
+}
+
+DeadlineStats PerformanceMonitor::getDeadlineStats() const {
+    return deadlineStats_;
+}
+
+const LatencyHistogram& PerformanceMonitor::getOvershootHistogram() const {
+    return overshootHistogram_;
+}
+
+double PerformanceMonitor::getTotalTime() const {
+    // 计时中按当前时间计算，供运行时显示实际吞吐
+    auto endTime = isRunning_ ? std::chrono::high_resolution_clock::now() : endTime_;
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime_);
+    return duration.count() / 1000.0;
 }
 
 double PerformanceMonitor::getAverageFPS() const {
@@ -51,17 +186,184 @@ int PerformanceMonitor::getTotalFrames() const {
     return totalFrames_;
 }
 
+double PerformanceMonitor::getWallClockFPS() const {
+    double totalTime = getTotalTime();
+    return totalTime > 0 ? totalFrames_ / totalTime : 0.0;
+}
+
+double PerformanceMonitor::getAverageLatency() const {
+    return latencyFrames_ > 0 ? totalLatency_ / latencyFrames_ : 0.0;
+}
+
+double PerformanceMonitor::getMaxLatency() const {
+    return maxLatency_;
+}
+
 void PerformanceMonitor::printStatistics() const {
     std::cout << "\n=== Performance Statistics ===" << std::endl;
     std::cout << "Total execution time: " << std::fixed << std::setprecision(2) << getTotalTime() << " seconds" << std::endl;
     std::cout << "Total frames processed: " << totalFrames_ << std::endl;
-    std::cout << "Average FPS: " << std::fixed << std::setprecision(1) << getAverageFPS() << std::endl;
+    std::cout << "Average FPS (1000 / inference time): " << std::fixed << std::setprecision(1) << getAverageFPS() << std::endl;
     std::cout << "Average inference time: " << std::fixed << std::setprecision(1) << getAverageInferenceTime() << " ms" << std::endl;
+    std::cout << "Throughput (wall-clock FPS): " << std::fixed << std::setprecision(1) << getWallClockFPS() << std::endl;
+    if (latencyFrames_ > 0) {
+        // 采集完成到检测、NMS、跟踪结果输出，包括排队和流水线深度带来的等待，决定瞄准时目标位置的滞后
+        std::cout << "Capture-to-result latency: mean " << std::fixed << std::setprecision(2) << getAverageLatency()
+                  << " ms, max " << getMaxLatency() << " ms" << std::endl;
+    }
+    if (renderFrames_ > 0 && renderOverlapped_) {
+        // 显示在独立阶段上与检测并行，只有它是最慢的阶段时才限制吞吐
+        std::cout << "Render + display time: " << std::fixed << std::setprecision(2)
+                  << totalRenderTime_ / renderFrames_ << " ms/frame (overlapped with detection, "
+                  << "see pipeline stage statistics)" << std::endl;
+    } else if (renderFrames_ > 0) {
+        // 去掉绘制和显示耗时后的墙钟帧率，即无界面模式的预期帧率
+        double renderMs = totalRenderTime_ / renderFrames_;
+        double headlessTime = getTotalTime() - totalRenderTime_ / 1000.0;
+        double headlessFPS = headlessTime > 0 ? totalFrames_ / headlessTime : 0.0;
+        double wallFPS = getWallClockFPS();
+        std::cout << "Render + display time: " << std::fixed << std::setprecision(2) << renderMs << " ms/frame" << std::endl;
+        std::cout << "Estimated headless FPS: " << std::fixed << std::setprecision(1) << headlessFPS;
+        if (wallFPS > 0) {
+            std::cout << " (+" << (headlessFPS / wallFPS - 1.0) * 100.0 << "%)";
+        }
+        std::cout << std::endl;
+    }
+    std::cout << "Startup time (load + compile): " << std::fixed << std::setprecision(1) << startupTime_ << " ms" << std::endl;
+    std::cout << "Warm-up time: " << std::fixed << std::setprecision(1) << warmupTime_ << " ms" << std::endl;
+    if (firstDetectionTime_ >= 0) {
+        std::cout << "Time to first detection: " << std::fixed << std::setprecision(1) << firstDetectionTime_ << " ms" << std::endl;
+    }
+    
+    // 各阶段耗时分布：卡顿体现在尾部，平均值看不出来
+    bool hasStageTimes = false;
+    for (int i = 0; i < StageCount; ++i) {
+        hasStageTimes = hasStageTimes || stageHistograms_[i].getCount() > 0;
+    }
+    if (hasStageTimes) {
+        std::cout << "Stage times (ms):" << std::endl;
+        std::cout << "  " << std::left << std::setw(12) << "stage" << std::right
+                  << std::setw(8) << "count" << std::setw(9) << "mean" << std::setw(9) << "p50"
+                  << std::setw(9) << "p95" << std::setw(9) << "p99" << std::setw(9) << "max" << std::endl;
+        for (int i = 0; i < StageCount; ++i) {
+            const LatencyHistogram& histogram = stageHistograms_[i];
+            if (histogram.getCount() == 0) continue;
+            std::cout << "  " << std::left << std::setw(12) << kStageNames[i] << std::right
+                      << std::setw(8) << histogram.getCount() << std::fixed << std::setprecision(2)
+                      << std::setw(9) << histogram.getMean()
+                      << std::setw(9) << histogram.getPercentile(50)
+                      << std::setw(9) << histogram.getPercentile(95)
+                      << std::setw(9) << histogram.getPercentile(99)
+                      << std::setw(9) << histogram.getMax() << std::endl;
+        }
+        // 超出分桶上限的记录不进入任何桶，落在其中的百分位数按实际最大值报告
+        for (int i = 0; i < StageCount; ++i) {
+            long long overflow = stageHistograms_[i].getOverflowCount();
+            if (overflow == 0) continue;
+            std::cout << "  " << kStageNames[i] << ": " << overflow << " sample(s) above the histogram range ("
+                      << std::setprecision(0) << LatencyHistogram::getRangeMax()
+                      << " ms), percentiles falling there report the max" << std::endl;
+        }
+    }
+    
+    // 截止时间：超时次数、最长连续超时、超时量分布和归因阶段
+    if (deadlineStats_.deadlineMs > 0 && deadlineStats_.frames > 0) {
+        std::cout << "Frame deadline " << std::fixed << std::setprecision(2) << deadlineStats_.deadlineMs << " ms: "
+                  << deadlineStats_.misses << "/" << deadlineStats_.frames << " missed ("
+                  << std::setprecision(2) << 100.0 * deadlineStats_.misses / deadlineStats_.frames << "%), longest streak "
+                  << deadlineStats_.longestStreak << std::endl;
+        if (deadlineStats_.misses > 0) {
+            std::cout << "  Overshoot: p50 " << overshootHistogram_.getPercentile(50)
+                      << " ms, p95 " << overshootHistogram_.getPercentile(95)
+                      << " ms, p99 " << overshootHistogram_.getPercentile(99)
+                      << " ms, max " << overshootHistogram_.getMax() << " ms" << std::endl;
+            std::cout << "  Misses by stage:";
+            for (int i = 0; i <= kWaitCulprit; ++i) {
+                if (missesByCulprit_[i] == 0) continue;
+                std::cout << " " << (i == kWaitCulprit ? "wait" : kStageNames[i]) << " " << missesByCulprit_[i]
+                          << " (mean overshoot " << overshootByCulprit_[i] / missesByCulprit_[i] << " ms)";
+            }
+            std::cout << std::endl;
+        }
+    }
     std::cout << "===============================" << std::endl;
 }
 
+void PerformanceMonitor::printLayerProfiles(const std::vector<LayerProfile>& layers, int topN) const {
+    std::cout << "\n=== Layer Profile ===" << std::endl;
+    if (layers.empty()) {
+        std::cout << "No layer profiling data (enable_profiling=1 and run at least one inference)" << std::endl;
+        std::cout << "=====================" << std::endl;
+        return;
+    }
+    
+    std::vector<const LayerProfile*> sorted = sortLayersByTime(layers);
+    double total = totalLayerTime(layers);
+    size_t shown = std::min(sorted.size(), static_cast<size_t>(std::max(0, topN)));
+    std::cout << "Layers executed: " << layers.size() << ", total real time per inference: " << std::fixed
+              << std::setprecision(3) << (sorted.front()->count > 0 ? total / sorted.front()->count : 0.0) << " ms" << std::endl;
+    std::cout << "Top " << shown << " layers by real time:" << std::endl;
+    std::cout << "  " << std::left << std::setw(40) << "layer" << std::setw(16) << "type" << std::setw(24) << "exec type"
+              << std::right << std::setw(10) << "real ms" << std::setw(10) << "cpu ms" << std::setw(8) << "%" << std::endl;
+    for (size_t i = 0; i < shown; ++i) {
+        const LayerProfile& layer = *sorted[i];
+        double calls = static_cast<double>(std::max(1LL, layer.count));
+        std::string name = layer.name.size() > 38 ? "..." + layer.name.substr(layer.name.size() - 35) : layer.name;
+        std::cout << "  " << std::left << std::setw(40) << name << std::setw(16) << layer.nodeType << std::setw(24) << layer.execType
+                  << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(10) << layer.realTimeMs / calls << std::setw(10) << layer.cpuTimeMs / calls
+                  << std::setprecision(1) << std::setw(8) << (total > 0 ? layer.realTimeMs / total * 100.0 : 0.0) << std::endl;
+    }
+    std::cout << "=====================" << std::endl;
+}
+
+bool PerformanceMonitor::writeLayerProfilesCsv(const std::vector<LayerProfile>& layers, const std::string& path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Cannot create layer profile file: " << path << std::endl;
+        return false;
+    }
+    
+    // 层名称中可能含逗号，统一加引号
+    double total = totalLayerTime(layers);
+    file << "layer,node_type,exec_type,count,total_real_ms,avg_real_ms,total_cpu_ms,avg_cpu_ms,percent" << std::endl;
+    file << std::fixed << std::setprecision(4);
+    for (const LayerProfile* layer : sortLayersByTime(layers)) {
+        double calls = static_cast<double>(std::max(1LL, layer->count));
+        std::string name = layer->name;
+        for (size_t pos = name.find('"'); pos != std::string::npos; pos = name.find('"', pos + 2)) {
+            name.insert(pos, 1, '"');
+        }
+        file << '"' << name << "\"," << layer->nodeType << "," << layer->execType << "," << layer->count << ","
+             << layer->realTimeMs << "," << layer->realTimeMs / calls << ","
+             << layer->cpuTimeMs << "," << layer->cpuTimeMs / calls << ","
+             << (total > 0 ? layer->realTimeMs / total * 100.0 : 0.0) << std::endl;
+    }
+    return true;
+}
+
 void PerformanceMonitor::reset() {
     totalFrames_ = 0;
     totalInferenceTime_ = 0.0;
     isRunning_ = false;
+    startupTime_ = 0.0;
+    warmupTime_ = 0.0;
+    firstDetectionTime_ = -1.0;
+    totalRenderTime_ = 0.0;
+    renderFrames_ = 0;
+    totalLatency_ = 0.0;
+    maxLatency_ = 0.0;
+    latencyFrames_ = 0;
+    for (auto& histogram : stageHistograms_) {
+        histogram.reset();
+    }
+    double deadline = deadlineStats_.deadlineMs;
+    deadlineStats_ = DeadlineStats();
+    deadlineStats_.deadlineMs = deadline;
+    overshootHistogram_.reset();
+    waitHistogram_.reset();
+    for (int i = 0; i <= kWaitCulprit; ++i) {
+        missesByCulprit_[i] = 0;
+        overshootByCulprit_[i] = 0.0;
+    }
 } 
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include "../include/ResultSink.h"
+#include "../ncnn/cpp/include/STrack.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <iostream>
+
+ResultSink::~ResultSink() {
+    close();
+}
+
+bool ResultSink::open(const std::string& path) {
+    close();
+    file_.open(path, std::ios::out | std::ios::trunc);
+    if (!file_.is_open()) {
+        std::cerr << "Cannot create result output file: " << path << std::endl;
+        return false;
+    }
+    writtenFrames_ = 0;
+    return true;
+}
+
+bool ResultSink::isOpen() const {
+    return file_.is_open();
+}
+
+void ResultSink::write(long long frameIndex, double timestampMs, double latencyMs,
+                       const std::vector<DetectionResult>& detections,
+                       const std::vector<STrack>& tracks) {
+    if (!file_.is_open()) return;
+
+    line_.clear();
+    append("{\"frame\":%lld,\"timestamp_ms\":", frameIndex);
+    appendNumber("%.3f", timestampMs);
+    append(",\"latency_ms\":");
+    appendNumber("%.3f", latencyMs);
+    append(",\"detections\":[");
+    for (size_t i = 0; i < detections.size(); ++i) {
+        const DetectionResult& detection = detections[i];
+        const cv::Rect& box = detection.boundingBox;
+        append("%s{\"class\":%d,\"color\":%d,\"confidence\":",
+               i > 0 ? "," : "", detection.classId, detection.colorId);
+        appendNumber("%.4f", detection.confidence);
+        append(",\"box\":[%d,%d,%d,%d],\"landmarks\":[", box.x, box.y, box.width, box.height);
+        for (size_t k = 0; k < detection.landmarks.size(); ++k) {
+            append(k > 0 ? ",[" : "[");
+            appendNumber("%.2f", detection.landmarks[k].x);
+            append(",");
+            appendNumber("%.2f", detection.landmarks[k].y);
+            append("]");
+        }
+        append("]}");
+    }
+
+    append("],\"tracks\":[");
+    for (size_t i = 0; i < tracks.size(); ++i) {
+        const STrack& track = tracks[i];
+        append("%s{\"id\":%d,\"score\":", i > 0 ? "," : "", track.track_id);
+        appendNumber("%.4f", track.score);
+        append(",\"box\":[");
+        for (int k = 0; k < 4; ++k) {
+            if (k > 0) append(",");
+            appendNumber("%.1f", track.tlwh[k]);
+        }
+        append("]}");
+    }
+    append("]}\n");
+
+    // 不逐帧flush，由文件流缓冲批量写盘
+    file_.write(line_.data(), static_cast<std::streamsize>(line_.size()));
+    writtenFrames_++;
+}
+
+void ResultSink::close() {
+    if (file_.is_open()) {
+        file_.close();
+    }
+}
+
+long long ResultSink::getWrittenFrames() const {
+    return writtenFrames_;
+}
+
+void ResultSink::append(const char* format, ...) {
+    // 先用行缓冲区的剩余容量格式化，放不下时按vsnprintf返回的长度扩容后重新格式化
+    size_t offset = line_.size();
+    size_t available = std::max<size_t>(line_.capacity() - offset, 64);
+    line_.resize(offset + available);
+
+    va_list args;
+    va_start(args, format);
+    va_list retry;
+    va_copy(retry, args);
+    int length = std::vsnprintf(&line_[offset], available, format, args);
+    va_end(args);
+    if (length >= 0 && static_cast<size_t>(length) >= available) {
+        line_.resize(offset + length + 1);
+        std::vsnprintf(&line_[offset], length + 1, format, retry);
+    }
+    va_end(retry);
+
+    line_.resize(offset + (length > 0 ? static_cast<size_t>(length) : 0));
+}
+
+void ResultSink::appendNumber(const char* format, double value) {
+    if (std::isfinite(value)) {
+        append(format, value);
+    } else {
+        line_.append("null");
+    }
+}
@@ -0,0 +1,199 @@
+#include "../include/StreamScheduler.h"
+#include "../ncnn/cpp/include/BYTETracker.h"
+#include "../ncnn/cpp/include/STrack.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+StreamScheduler::StreamScheduler(Detector& detector, FramePool* framePool)
+    : detector_(detector), framePool_(framePool) {
+}
+
+StreamScheduler::~StreamScheduler() {
+    for (auto& stream : streams_) {
+        stream->grabber->stop();
+    }
+}
+
+int StreamScheduler::addStream(const Config& config, const std::string& name) {
+    std::unique_ptr<Stream> stream(new Stream());
+    stream->name = name;
+    stream->config = config;
+    stream->capture.open(config.getVideoPath());
+    if (!stream->capture.isOpened()) {
+        throw std::runtime_error("Cannot open video file: " + config.getVideoPath());
+    }
+
+    // 每路都由后台线程采集到单帧邮箱，调度时只取最新帧；录像文件按其帧率节流以模拟相机
+    const bool isVideoFile = stream->capture.get(cv::CAP_PROP_FRAME_COUNT) > 0;
+    stream->grabber.reset(new LatestFrameGrabber(stream->capture,
+                                                 isVideoFile ? stream->capture.get(cv::CAP_PROP_FPS) : 0.0,
+                                                 framePool_));
+    stream->tracker.reset(new BYTETracker(60, 60));
+
+    streams_.push_back(std::move(stream));
+    return static_cast<int>(streams_.size()) - 1;
+}
+
+int StreamScheduler::getStreamCount() const {
+    return static_cast<int>(streams_.size());
+}
+
+cv::Size StreamScheduler::getFrameSize(int streamIndex) const {
+    const cv::VideoCapture& capture = streams_[streamIndex]->capture;
+    return cv::Size(static_cast<int>(capture.get(cv::CAP_PROP_FRAME_WIDTH)),
+                    static_cast<int>(capture.get(cv::CAP_PROP_FRAME_HEIGHT)));
+}
+
+void StreamScheduler::run(const ResultCallback& onResult) {
+    for (auto& stream : streams_) {
+        stream->grabber->start();
+    }
+    runStart_ = std::chrono::steady_clock::now();
+    runEnd_ = runStart_;
+
+    bool keepRunning = true;
+    while (keepRunning) {
+        // 空闲推理请求按轮转顺序分给有新帧的流
+        bool submitted = false;
+        while (detector_.canSubmit() && submitNextStream()) {
+            submitted = true;
+        }
+
+        // 请求已用完或暂时没有新帧时取出最早提交帧的结果，释放一个请求
+        if (!inFlight_.empty() && (!detector_.canSubmit() || !submitted)) {
+            keepRunning = completeOldest(onResult);
+            continue;
+        }
+
+        if (inFlight_.empty() && allStreamsFinished()) break;
+
+        // 没有在途推理也没有新帧，短暂等待采集线程
+        if (!submitted) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+
+    // 停止采集并丢弃仍在推理的帧，释放推理请求和对帧的引用
+    for (auto& stream : streams_) {
+        stream->grabber->stop();
+    }
+    while (detector_.flushPipeline(frameResult_)) {
+        inFlight_.pop_front();
+    }
+    frameResult_.frame.release();
+    runEnd_ = std::chrono::steady_clock::now();
+}
+
+bool StreamScheduler::submitNextStream() {
+    cv::Mat frame;
+    std::chrono::steady_clock::time_point grabTime;
+
+    for (size_t k = 0; k < streams_.size(); ++k) {
+        size_t index = (nextStream_ + k) % streams_.size();
+        Stream& stream = *streams_[index];
+        if (!stream.grabber->tryRead(frame, &grabTime)) continue;
+
+        detector_.submit(frame, stream.config.getDetectColor(), grabTime);
+        inFlight_.push_back({static_cast<int>(index)});
+
+        // 下次从该流之后开始，保证各路轮流获得推理请求
+        nextStream_ = (index + 1) % streams_.size();
+        return true;
+    }
+    return false;
+}
+
+bool StreamScheduler::completeOldest(const ResultCallback& onResult) {
+    detector_.flushPipeline(frameResult_);
+    InFlightFrame inFlight = inFlight_.front();
+    inFlight_.pop_front();
+    Stream& stream = *streams_[inFlight.streamIndex];
+
+    // 按该路的阈值和NMS方式筛选，并调整到原始尺寸
+    const Config& config = stream.config;
+    imageProcessor_.applyNMSByMode(frameResult_.detections, config.getConfidenceThreshold(), config.getNMSThreshold(),
+                                   config.getNMSMode(), config.getNMSMergeLandmarks(), filtered_);
+    std::vector<DetectionResult> detections = imageProcessor_.scaleResultsToOriginal(
+        filtered_, frameResult_.frame.size(), detector_.getInputSize());
+
+    // 该路独立跟踪；结果按提交顺序取出，跟踪器看到的帧序与该路视频一致
+    std::vector<Object> objects;
+    objects.reserve(detections.size());
+    for (const auto& detection : detections) {
+        Object obj;
+        obj.rect = detection.boundingBox;
+        obj.label = detection.classId;
+        obj.prob = detection.confidence;
+        objects.push_back(obj);
+    }
+    std::vector<STrack> tracks = stream.tracker->update(objects);
+
+    double latencyMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - frameResult_.captureTime).count();
+    stream.processedFrames++;
+    stream.latencySumMs += latencyMs;
+    stream.latencyMaxMs = std::max(stream.latencyMaxMs, latencyMs);
+
+    bool keepRunning = true;
+    if (onResult) {
+        keepRunning = onResult(inFlight.streamIndex, frameResult_.frame, detections, tracks, latencyMs);
+    }
+    frameResult_.frame.release();
+    return keepRunning;
+}
+
+bool StreamScheduler::allStreamsFinished() const {
+    for (const auto& stream : streams_) {
+        if (!stream->grabber->isFinished()) return false;
+    }
+    return true;
+}
+
+StreamStats StreamScheduler::getStreamStats(int streamIndex) const {
+    const Stream& stream = *streams_[streamIndex];
+    StreamStats stats;
+    stats.name = stream.name;
+    stats.processedFrames = stream.processedFrames;
+    stats.droppedFrames = stream.grabber->getDroppedFrames();
+
+    // 调度进行中按当前时间计算
+    auto end = runEnd_ > runStart_ ? runEnd_ : std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - runStart_).count();
+    if (seconds > 0.0) {
+        stats.fps = stream.processedFrames / seconds;
+    }
+    if (stream.processedFrames > 0) {
+        stats.meanLatencyMs = stream.latencySumMs / stream.processedFrames;
+    }
+    stats.maxLatencyMs = stream.latencyMaxMs;
+    return stats;
+}
+
+void StreamScheduler::printStatistics() const {
+    std::cout << "\n=== Multi-Stream Statistics ===" << std::endl;
+    std::cout << "Streams: " << streams_.size() << ", shared infer requests: " << detector_.getPipelineDepth() << std::endl;
+    std::cout << std::left << std::setw(16) << "Stream"
+              << std::right << std::setw(10) << "Frames"
+              << std::setw(10) << "Dropped"
+              << std::setw(10) << "FPS"
+              << std::setw(14) << "Mean lat(ms)"
+              << std::setw(14) << "Max lat(ms)" << std::endl;
+
+    double totalFps = 0.0;
+    for (int i = 0; i < getStreamCount(); ++i) {
+        StreamStats stats = getStreamStats(i);
+        totalFps += stats.fps;
+        std::cout << std::left << std::setw(16) << stats.name
+                  << std::right << std::setw(10) << stats.processedFrames
+                  << std::setw(10) << stats.droppedFrames
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(10) << stats.fps
+                  << std::setw(14) << stats.meanLatencyMs
+                  << std::setw(14) << stats.maxLatencyMs << std::endl;
+    }
+    std::cout << "Aggregate FPS: " << std::setprecision(1) << totalFps << std::endl;
+    std::cout << "==================================" << std::endl;
+}
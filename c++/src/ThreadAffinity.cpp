@@ -0,0 +1,81 @@
+#include "../include/ThreadAffinity.h"
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+std::vector<int> ThreadAffinity::parseCoreList(const std::string& text) {
+    std::vector<int> cores;
+    std::stringstream stream(text);
+    std::string item;
+
+    while (std::getline(stream, item, ',')) {
+        // 去除前后空格
+        item.erase(0, item.find_first_not_of(" \t"));
+        item.erase(item.find_last_not_of(" \t") + 1);
+        if (item.empty()) continue;
+
+        try {
+            size_t dash = item.find('-');
+            if (dash == std::string::npos) {
+                cores.push_back(std::stoi(item));
+            } else {
+                int first = std::stoi(item.substr(0, dash));
+                int last = std::stoi(item.substr(dash + 1));
+                if (first > last) throw std::invalid_argument("descending range");
+                for (int core = first; core <= last; ++core) {
+                    cores.push_back(core);
+                }
+            }
+        }
+        catch (const std::exception&) {
+            throw std::invalid_argument("Invalid core list: " + text);
+        }
+        if (cores.back() < 0) {
+            throw std::invalid_argument("Invalid core list: " + text);
+        }
+    }
+
+    std::sort(cores.begin(), cores.end());
+    cores.erase(std::unique(cores.begin(), cores.end()), cores.end());
+    return cores;
+}
+
+bool ThreadAffinity::pinCurrentThread(const std::vector<int>& cores) {
+    if (cores.empty()) return true;
+
+#if defined(_WIN32)
+    // 单个处理器组内最多64个逻辑核心
+    DWORD_PTR mask = 0;
+    for (int core : cores) {
+        if (core >= static_cast<int>(sizeof(DWORD_PTR) * 8)) return false;
+        mask |= static_cast<DWORD_PTR>(1) << core;
+    }
+    return SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int core : cores) {
+        if (core >= CPU_SETSIZE) return false;
+        CPU_SET(core, &set);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+std::string ThreadAffinity::formatCoreList(const std::vector<int>& cores) {
+    std::string text;
+    for (size_t i = 0; i < cores.size(); ++i) {
+        if (i > 0) text += ",";
+        text += std::to_string(cores[i]);
+    }
+    return text;
+}
@@ -0,0 +1,208 @@
+#include "../include/TraceRecorder.h"
+#include "../include/SPSCQueue.h"
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+std::atomic<bool> TraceRecorder::enabled_{false};
+
+namespace {
+
+// 单个区间事件
+struct TraceEvent {
+    const char* name = nullptr;                         // 区间名称（字符串常量）
+    TraceRecorder::Clock::time_point begin;             // 开始时间
+    TraceRecorder::Clock::time_point end;               // 结束时间
+    long long frameIndex = -1;                          // 帧序号
+};
+
+// 每个线程的事件缓冲区：所属线程写入，后台写文件线程取出
+struct ThreadBuffer {
+    static constexpr size_t kCapacity = 4096;           // 两次写文件之间单个线程最多缓存的事件数
+
+    int tid = 0;                                        // 追踪视图中的线程号
+    std::string name;                                   // 线程名称
+    bool nameWritten = false;                           // 本次记录中是否已输出线程名称
+    SPSCQueue<TraceEvent> queue{kCapacity};             // 事件队列
+};
+
+// 记录会话状态
+struct TraceSession {
+    std::mutex controlMutex;                            // 保护start/stop
+    std::mutex registryMutex;                           // 保护线程缓冲区列表和线程名称
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers; // 所有线程的缓冲区（线程退出后保留，事件仍可写出）
+    int nextTid = 1;                                    // 下一个线程号
+
+    FILE* file = nullptr;                               // 输出文件
+    bool firstEvent = true;                             // 是否尚未写出事件（决定是否输出分隔符）
+    TraceRecorder::Clock::time_point origin;            // 时间零点
+    std::atomic<long long> droppedEvents{0};            // 缓冲区已满而丢弃的事件数
+
+    std::thread flushThread;                            // 后台写文件线程
+    std::mutex flushMutex;                              // 保护stopRequested
+    std::condition_variable flushCondition;             // 唤醒写文件线程
+    bool stopRequested = false;                         // 是否请求停止
+
+    // 程序退出时仍在记录（如异常退出），写出剩余事件，避免未结束的后台线程终止进程
+    ~TraceSession();
+};
+
+TraceSession& session() {
+    static TraceSession instance;
+    return instance;
+}
+
+ThreadBuffer& currentThreadBuffer() {
+    thread_local std::shared_ptr<ThreadBuffer> buffer;
+    if (!buffer) {
+        buffer = std::make_shared<ThreadBuffer>();
+        TraceSession& s = session();
+        std::lock_guard<std::mutex> lock(s.registryMutex);
+        buffer->tid = s.nextTid++;
+        s.buffers.push_back(buffer);
+    }
+    return *buffer;
+}
+
+// 转义线程名称中的反斜杠和引号
+std::string jsonEscape(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '\\' || c == '"') escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+
+// 写出事件之间的分隔符
+void writeSeparator(TraceSession& s) {
+    std::fputs(s.firstEvent ? "\n" : ",\n", s.file);
+    s.firstEvent = false;
+}
+
+// 取出所有线程缓冲区中的事件，writeEvents为false时直接丢弃；任意时刻只能有一个线程调用
+void drainBuffers(TraceSession& s, bool writeEvents) {
+    std::lock_guard<std::mutex> lock(s.registryMutex);
+    TraceEvent event;
+    for (const auto& buffer : s.buffers) {
+        if (writeEvents && !buffer->nameWritten && !buffer->name.empty()) {
+            writeSeparator(s);
+            std::fprintf(s.file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                         buffer->tid, jsonEscape(buffer->name).c_str());
+            buffer->nameWritten = true;
+        }
+        while (buffer->queue.tryPop(event)) {
+            if (!writeEvents) continue;
+            double ts = std::chrono::duration<double, std::micro>(event.begin - s.origin).count();
+            double dur = std::chrono::duration<double, std::micro>(event.end - event.begin).count();
+            writeSeparator(s);
+            std::fprintf(s.file, "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f",
+                         event.name, buffer->tid, ts, dur);
+            if (event.frameIndex >= 0) {
+                std::fprintf(s.file, ",\"args\":{\"frame\":%lld}", event.frameIndex);
+            }
+            std::fputc('}', s.file);
+        }
+    }
+}
+
+// 后台写文件线程：定期取出各线程的事件，停止时再取一次
+void flushLoop(TraceSession& s) {
+    std::unique_lock<std::mutex> lock(s.flushMutex);
+    while (!s.stopRequested) {
+        s.flushCondition.wait_for(lock, std::chrono::milliseconds(100));
+        lock.unlock();
+        drainBuffers(s, true);
+        lock.lock();
+    }
+    lock.unlock();
+    drainBuffers(s, true);
+}
+
+void stopSession(TraceSession& s) {
+    if (!s.file) return;
+
+    {
+        std::lock_guard<std::mutex> lock(s.flushMutex);
+        s.stopRequested = true;
+    }
+    s.flushCondition.notify_one();
+    s.flushThread.join();
+
+    std::fprintf(s.file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+    std::fclose(s.file);
+    s.file = nullptr;
+}
+
+TraceSession::~TraceSession() {
+    stopSession(*this);
+}
+
+} // namespace
+
+bool TraceRecorder::start(const std::string& path) {
+    TraceSession& s = session();
+    std::lock_guard<std::mutex> control(s.controlMutex);
+    enabled_.store(false, std::memory_order_relaxed);
+    stopSession(s);
+
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        std::fprintf(stderr, "Cannot create trace file: %s\n", path.c_str());
+        return false;
+    }
+
+    // 丢弃上一次停止后才结束的区间，并让线程名称在新文件中重新输出
+    drainBuffers(s, false);
+    {
+        std::lock_guard<std::mutex> lock(s.registryMutex);
+        for (const auto& buffer : s.buffers) {
+            buffer->nameWritten = false;
+        }
+    }
+
+    s.file = file;
+    s.firstEvent = true;
+    s.origin = Clock::now();
+    s.droppedEvents.store(0, std::memory_order_relaxed);
+    s.stopRequested = false;
+    std::fprintf(s.file, "{\"traceEvents\":[");
+    s.flushThread = std::thread(flushLoop, std::ref(s));
+    enabled_.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+void TraceRecorder::stop() {
+    TraceSession& s = session();
+    std::lock_guard<std::mutex> control(s.controlMutex);
+    enabled_.store(false, std::memory_order_relaxed);
+    stopSession(s);
+}
+
+void TraceRecorder::setThreadName(const std::string& name) {
+    ThreadBuffer& buffer = currentThreadBuffer();
+    TraceSession& s = session();
+    std::lock_guard<std::mutex> lock(s.registryMutex);
+    buffer.name = name;
+    buffer.nameWritten = false;
+}
+
+void TraceRecorder::record(const char* name, Clock::time_point begin, Clock::time_point end, long long frameIndex) {
+    if (!isEnabled()) return;
+
+    TraceEvent event;
+    event.name = name;
+    event.begin = begin;
+    event.end = end;
+    event.frameIndex = frameIndex;
+    if (!currentThreadBuffer().queue.tryPush(std::move(event))) {
+        session().droppedEvents.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+long long TraceRecorder::getDroppedEvents() {
+    return session().droppedEvents.load(std::memory_order_relaxed);
+}
@@ -1,9 +1,11 @@
 #include "../include/Visualizer.h"
+#include "../include/TraceRecorder.h"
 #include "../ncnn/cpp/include/STrack.h"
 #include <sstream>
 #include <iomanip>
 
 void Visualizer::drawDetections(cv::Mat& image, const std::vector<DetectionResult>& detections) {
+    TraceZone zone("Visualizer::drawDetections");
     for (const auto& detection : detections) {
         // 构建标签
         std::string colorName = getColorName(detection.colorId);
@@ -22,6 +24,7 @@ void Visualizer::drawDetections(cv::Mat& image, const std::vector<DetectionResul
 }
 
 void Visualizer::drawTracks(cv::Mat& image, const std::vector<STrack>& tracks) {
+    TraceZone zone("Visualizer::drawTracks");
     for (const auto& track : tracks) {
         // 获取跟踪边界框
         std::vector<float> tlbr = track.tlbr;
@@ -69,7 +72,9 @@ void Visualizer::drawTracks(cv::Mat& image, const std::vector<STrack>& tracks) {
     }
 }
 
-void Visualizer::drawPerformanceInfo(cv::Mat& image, double fps, double inferenceTime) {
+void Visualizer::drawPerformanceInfo(cv::Mat& image, double fps, double inferenceTime, double latency,
+                                     const DeadlineStats& deadline) {
+    TraceZone zone("Visualizer::drawPerformanceInfo");
     std::ostringstream fpsText;
     fpsText << "FPS: " << std::fixed << std::setprecision(1) << fps;
     
@@ -83,9 +88,28 @@ void Visualizer::drawPerformanceInfo(cv::Mat& image, double fps, double inferenc
     // 绘制推理时间信息
     cv::putText(image, timeText.str(), cv::Point(10, 70), 
                 cv::FONT_HERSHEY_SIMPLEX, 0.7, cv::Scalar(0, 255, 0), 2);
+    
+    // 绘制采集到出结果的延迟
+    if (latency >= 0) {
+        std::ostringstream latencyText;
+        latencyText << "Latency: " << std::fixed << std::setprecision(1) << latency << "ms";
+        cv::putText(image, latencyText.str(), cv::Point(10, 100), 
+                    cv::FONT_HERSHEY_SIMPLEX, 0.7, cv::Scalar(0, 255, 0), 2);
+    }
+    
+    // 绘制超出帧预算的次数，当前帧超时时显示为红色
+    if (deadline.deadlineMs > 0) {
+        std::ostringstream deadlineText;
+        deadlineText << "Deadline " << std::fixed << std::setprecision(1) << deadline.deadlineMs << "ms missed: "
+                     << deadline.misses << "/" << deadline.frames << ", streak " << deadline.currentStreak
+                     << " (max " << deadline.longestStreak << ")";
+        cv::Scalar color = deadline.lastMissed ? cv::Scalar(0, 0, 255) : cv::Scalar(0, 255, 0);
+        cv::putText(image, deadlineText.str(), cv::Point(10, 130), 
+                    cv::FONT_HERSHEY_SIMPLEX, 0.7, color, 2);
+    }
 }
 
-void Visualizer::drawLandmarks(cv::Mat& image, const std::vector<cv::Point2f>& landmarks) {
+void Visualizer::drawLandmarks(cv::Mat& image, const std::array<cv::Point2f, 4>& landmarks) {
     for (const auto& landmark : landmarks) {
         cv::circle(image, landmark, 2, cv::Scalar(255, 0, 255), -1);
     }
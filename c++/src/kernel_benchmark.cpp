@@ -0,0 +1,205 @@
+#include <iostream>
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#include "../include/FusedPreprocessor.h"
+#include "../include/ImageProcessor.h"
+
+// 内核基准测试：
+//   1. 原有多步预处理链与融合预处理内核的耗时和结果差异
+//   2. cv::dnn::NMSBoxes与四边形IoU NMS在不同候选数量下的耗时
+//
+// 用法：kernel_benchmark [视频文件] [迭代次数]
+//   未指定视频时使用1280x1024随机图像，目标尺寸固定为640x640
+
+// 基准测试计时结果
+struct BenchmarkTiming {
+    double meanMs = 0.0;                            // 平均耗时（毫秒）
+    double minMs = 0.0;                             // 最小耗时（毫秒）
+};
+
+// 原有预处理链：resize -> cvtColor -> convertTo -> split -> memcpy
+static void referencePreprocess(const cv::Mat& frame, const cv::Size& inputSize, float* output) {
+    cv::Mat resized, rgb;
+    cv::resize(frame, resized, inputSize);
+    cv::cvtColor(resized, rgb, cv::COLOR_BGR2RGB);
+    rgb.convertTo(rgb, CV_32F, 1.0 / 255.0);
+
+    std::vector<cv::Mat> channels(3);
+    cv::split(rgb, channels);
+    size_t planeSize = static_cast<size_t>(inputSize.width) * inputSize.height;
+    for (int c = 0; c < 3; ++c) {
+        memcpy(output + c * planeSize, channels[c].data, planeSize * sizeof(float));
+    }
+}
+
+// 重复执行并统计耗时
+template <typename Func>
+static BenchmarkTiming measure(int iterations, Func func) {
+    BenchmarkTiming timing;
+    timing.minMs = 1e9;
+    double total = 0.0;
+    for (int i = 0; i < iterations; ++i) {
+        auto start = std::chrono::high_resolution_clock::now();
+        func();
+        auto end = std::chrono::high_resolution_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        total += ms;
+        timing.minMs = std::min(timing.minMs, ms);
+    }
+    timing.meanMs = total / iterations;
+    return timing;
+}
+
+// 生成NMS候选：围绕若干装甲板随机抖动并旋转，模拟模型对同一目标的重复输出
+static std::vector<DetectionResult> makeNMSCandidates(int count, cv::RNG& rng) {
+    const int numTargets = std::max(1, count / 20);
+    std::vector<DetectionResult> candidates;
+    candidates.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        cv::RNG targetRng(static_cast<uint64_t>(i % numTargets) + 1);
+        cv::Point2f center(targetRng.uniform(50.0f, 590.0f), targetRng.uniform(50.0f, 590.0f));
+        float width = targetRng.uniform(20.0f, 80.0f);
+        float angle = targetRng.uniform(-60.0f, 60.0f);
+        int classId = targetRng.uniform(0, 8);
+        
+        cv::Point2f jitter(rng.uniform(-4.0f, 4.0f), rng.uniform(-4.0f, 4.0f));
+        cv::RotatedRect plate(center + jitter, cv::Size2f(width * rng.uniform(0.9f, 1.1f), width * 0.45f),
+                              angle + rng.uniform(-5.0f, 5.0f));
+        cv::Point2f corners[4];
+        plate.points(corners);
+        
+        DetectionResult result;
+        for (int k = 0; k < 4; ++k) {
+            result.landmarks[k] = corners[k];
+        }
+        result.boundingBox = plate.boundingRect();
+        result.confidence = rng.uniform(0.3f, 1.0f);
+        result.classId = classId;
+        result.colorId = 1;
+        candidates.push_back(result);
+    }
+    return candidates;
+}
+
+// 预处理内核对比
+static void runPreprocessBenchmark(const cv::Mat& frame, int iterations) {
+    const cv::Size inputSize(640, 640);
+    size_t tensorSize = 3 * static_cast<size_t>(inputSize.width) * inputSize.height;
+    std::vector<float> referenceOutput(tensorSize);
+    std::vector<float> fusedOutput(tensorSize);
+    FusedPreprocessor fusedPreprocessor;
+
+    // 预热（建立采样表、线程池）
+    referencePreprocess(frame, inputSize, referenceOutput.data());
+    fusedPreprocessor.process(frame, inputSize, fusedOutput.data());
+
+    // ==================== 计时 ====================
+    BenchmarkTiming reference = measure(iterations, [&]() {
+        referencePreprocess(frame, inputSize, referenceOutput.data());
+    });
+    BenchmarkTiming fused = measure(iterations, [&]() {
+        fusedPreprocessor.process(frame, inputSize, fusedOutput.data());
+    });
+
+    // ==================== 结果一致性 ====================
+    // cv::resize内部使用定点插值，与浮点插值存在约1/255以内的差异
+    double maxDiff = 0.0;
+    for (size_t i = 0; i < tensorSize; ++i) {
+        maxDiff = std::max(maxDiff, static_cast<double>(std::fabs(referenceOutput[i] - fusedOutput[i])));
+    }
+
+    std::cout << "=== Preprocess Kernel Benchmark ===" << std::endl;
+    std::cout << "Input: " << frame.cols << "x" << frame.rows << " -> "
+              << inputSize.width << "x" << inputSize.height
+              << ", iterations: " << iterations << ", threads: " << cv::getNumThreads() << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << std::left << std::setw(12) << "Path"
+              << std::right << std::setw(12) << "Mean ms" << std::setw(12) << "Min ms" << std::endl;
+    std::cout << std::left << std::setw(12) << "chain"
+              << std::right << std::setw(12) << reference.meanMs << std::setw(12) << reference.minMs << std::endl;
+    std::cout << std::left << std::setw(12) << "fused"
+              << std::right << std::setw(12) << fused.meanMs << std::setw(12) << fused.minMs << std::endl;
+    std::cout << "Speedup: " << std::setprecision(2) << reference.meanMs / fused.meanMs << "x" << std::endl;
+    std::cout << "Max abs diff: " << std::setprecision(6) << maxDiff << std::endl;
+}
+
+// NMS对比：每次计时都包含构造NMSBoxes输入和收集输出结果
+static void runNMSBenchmark(int iterations) {
+    const float confidenceThreshold = 0.45f;
+    const float nmsThreshold = 0.45f;
+    ImageProcessor imageProcessor;
+    cv::RNG rng(12345);
+
+    std::cout << "\n=== NMS Benchmark ===" << std::endl;
+    std::cout << std::left << std::setw(12) << "Candidates"
+              << std::right << std::setw(12) << "Box ms" << std::setw(12) << "Quad ms"
+              << std::setw(14) << "Quad+merge ms" << std::setw(10) << "Box kept" << std::setw(11) << "Quad kept" << std::endl;
+
+    for (int count : {50, 100, 300, 1000}) {
+        std::vector<DetectionResult> candidates = makeNMSCandidates(count, rng);
+        std::vector<DetectionResult> boxKept, quadKept;
+        std::vector<cv::Rect> boxes;
+        std::vector<float> confidences;
+
+        BenchmarkTiming box = measure(iterations, [&]() {
+            boxes.clear();
+            confidences.clear();
+            for (const auto& candidate : candidates) {
+                boxes.push_back(candidate.boundingBox);
+                confidences.push_back(candidate.confidence);
+            }
+            std::vector<int> indices = imageProcessor.applyNMS(boxes, confidences, confidenceThreshold, nmsThreshold);
+            boxKept.clear();
+            for (int idx : indices) {
+                boxKept.push_back(candidates[idx]);
+            }
+        });
+        BenchmarkTiming quad = measure(iterations, [&]() {
+            imageProcessor.applyQuadNMS(candidates, confidenceThreshold, nmsThreshold, false, quadKept);
+        });
+        BenchmarkTiming merge = measure(iterations, [&]() {
+            imageProcessor.applyQuadNMS(candidates, confidenceThreshold, nmsThreshold, true, quadKept);
+        });
+
+        std::cout << std::left << std::setw(12) << count << std::right << std::fixed << std::setprecision(4)
+                  << std::setw(12) << box.meanMs << std::setw(12) << quad.meanMs << std::setw(14) << merge.meanMs
+                  << std::setw(10) << boxKept.size() << std::setw(11) << quadKept.size() << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    try {
+        int iterations = argc > 2 ? std::max(1, std::atoi(argv[2])) : 200;
+
+        // ==================== 准备输入图像 ====================
+        cv::Mat frame;
+        if (argc > 1) {
+            cv::VideoCapture cap(argv[1]);
+            if (!cap.isOpened() || !cap.read(frame)) {
+                std::cerr << "Cannot read frame from: " << argv[1] << std::endl;
+                return -1;
+            }
+        }
+        else {
+            frame.create(1024, 1280, CV_8UC3);
+            cv::randu(frame, cv::Scalar::all(0), cv::Scalar::all(256));
+        }
+
+        runPreprocessBenchmark(frame, iterations);
+        runNMSBenchmark(iterations);
+
+        return 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Program execution error: " << e.what() << std::endl;
+        return -1;
+    }
+}
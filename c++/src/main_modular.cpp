@@ -1,6 +1,8 @@
 #include <iostream>
 #include <opencv2/opencv.hpp>
 #include <chrono>
+#include <algorithm>
+#include <functional>
 #include <vector>
 
 // 包含自定义模块头文件
@@ -9,25 +11,268 @@
 #include "../include/ImageProcessor.h"
 #include "../include/Visualizer.h"
 #include "../include/PerformanceMonitor.h"
+#include "../include/FramePipeline.h"
+#include "../include/LatestFrameGrabber.h"
+#include "../include/ResultSink.h"
+#include "../include/FramePool.h"
+#include "../include/ThreadAffinity.h"
+#include "../include/TraceRecorder.h"
+#include "../include/AllocationTracker.h"
 
 // 包含BYTETracker相关头文件
 #include "../ncnn/cpp/include/BYTETracker.h"
 #include "../ncnn/cpp/include/STrack.h"
 
-int main() {
+// ROI模式下batch_size未设为大于1时使用的批大小（同时跟踪的装甲板通常不超过4块）
+static const int kRoiBatchSize = 4;
+
+// 按配置的NMS方式筛选并返回保留的检测结果
+static std::vector<DetectionResult> applyNMSToDetections(ImageProcessor& imageProcessor,
+                                                         const std::vector<DetectionResult>& detections,
+                                                         const Config& config) {
+    std::vector<DetectionResult> filteredDetections;
+    imageProcessor.applyNMSByMode(detections, config.getConfidenceThreshold(), config.getNMSThreshold(),
+                                  config.getNMSMode(), config.getNMSMergeLandmarks(), filteredDetections);
+    return filteredDetections;
+}
+
+// 转换为BYTETracker需要的Object格式并执行跟踪
+static std::vector<STrack> trackDetections(BYTETracker& tracker, const std::vector<DetectionResult>& detections) {
+    AllocationScope allocationScope(AllocationTracker::TrackStage);
+    std::vector<Object> objects;
+    for (const auto& detection : detections) {
+        Object obj;
+        obj.rect = detection.boundingBox;
+        obj.label = detection.classId;
+        obj.prob = detection.confidence;
+        objects.push_back(obj);
+    }
+    return tracker.update(objects);
+}
+
+// 从start到现在经过的毫秒数
+static double millisecondsSince(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+// 将检测器最近一次完成的检测的分项耗时计入各阶段直方图，并记入该帧的阶段耗时
+static void recordDetectorTiming(PerformanceMonitor& performanceMonitor, const DetectorTiming& timing,
+                                 PerformanceMonitor::FrameStageTimes& stageTimes) {
+    stageTimes[PerformanceMonitor::PreprocessStage] = timing.preprocessMs;
+    stageTimes[PerformanceMonitor::InferStage] = timing.inferMs;
+    stageTimes[PerformanceMonitor::PostprocessStage] = timing.postprocessMs;
+    performanceMonitor.recordStageTime(PerformanceMonitor::PreprocessStage, timing.preprocessMs);
+    performanceMonitor.recordStageTime(PerformanceMonitor::InferStage, timing.inferMs);
+    performanceMonitor.recordStageTime(PerformanceMonitor::PostprocessStage, timing.postprocessMs);
+}
+
+// 记录该帧某阶段的耗时
+static void recordFrameStage(PerformanceMonitor& performanceMonitor, PerformanceMonitor::FrameStageTimes& stageTimes,
+                             PerformanceMonitor::Stage stage, double stageTime) {
+    stageTimes[stage] = stageTime;
+    performanceMonitor.recordStageTime(stage, stageTime);
+}
+
+// 从采集完成到现在经过的毫秒数
+static double millisecondsSinceCapture(std::chrono::steady_clock::time_point captureTime) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - captureTime).count();
+}
+
+#if !defined(DETECTION_HEADLESS)
+// 在图像副本上绘制检测、跟踪和性能信息并显示，按'q'时返回false
+// 副本从缓冲池分配，显示后回池供下一帧复用
+// fps为实际吞吐（墙钟帧率），latency为采集到出结果的延迟，deadline为帧预算的超时统计
+static bool displayResult(Visualizer& visualizer, FramePool& framePool, const cv::Mat& frame,
+                          const std::vector<DetectionResult>& detections,
+                          const std::vector<STrack>& tracks,
+                          double fps, double inferenceTime, double latency,
+                          const DeadlineStats& deadline) {
+    AllocationScope allocationScope(AllocationTracker::DrawStage);
+    cv::Mat displayFrame;
+    framePool.attach(displayFrame);
+    frame.copyTo(displayFrame);
+    
+    // 绘制检测结果
+    visualizer.drawDetections(displayFrame, detections);
+    
+    // 绘制跟踪结果
+    visualizer.drawTracks(displayFrame, tracks);
+    
+    // 绘制性能信息
+    visualizer.drawPerformanceInfo(displayFrame, fps, inferenceTime, latency, deadline);
+    
+    // 显示结果
+    TraceZone zone("imshow");
+    cv::imshow("OpenVINO Detection Result", displayFrame);
+    
+    // 检查按键：按'q'退出
+    return cv::waitKey(1) != 'q';
+}
+#endif
+
+// 读取一帧，grabTime非空时写入采集完成时间
+using FrameReader = std::function<bool(cv::Mat&, std::chrono::steady_clock::time_point*)>;
+
+// 多线程流水线：采集、检测、跟踪各占一个线程，显示在主线程
+// latestOnly为true时检测阶段只处理最新帧
+static void runThreadedPipeline(const Config& config, const FrameReader& readFrame, bool latestOnly,
+                                Detector& detector, ImageProcessor& imageProcessor, Visualizer& visualizer,
+                                PerformanceMonitor& performanceMonitor, BYTETracker& tracker,
+                                ResultSink& resultSink, FramePool& framePool, bool headless,
+                                std::chrono::high_resolution_clock::time_point programStart) {
+    FramePipeline pipeline(static_cast<size_t>(std::max(1, config.getPipelineQueueSize())));
+    std::vector<DetectionResult> detections;    // 仅检测线程使用
+    long long outputFrames = 0;                 // 已输出帧数（仅显示线程使用），与单线程循环的结果帧序号一致
+    performanceMonitor.setRenderOverlapped(true);
+    
+    // 检测线程逐帧同步推理，同一时刻只占用一个推理请求，多余的请求不会重叠
+    if (detector.getPipelineDepth() > 1) {
+        std::cout << "Warning: threaded pipeline infers one frame at a time, num_infer_requests="
+                  << detector.getPipelineDepth() << " has no effect (use threaded_pipeline=0 for pipelined requests)"
+                  << std::endl;
+    }
+    pipeline.setLatestOnly(latestOnly);
+    pipeline.setStageCores(ThreadAffinity::parseCoreList(config.getCaptureCores()),
+                           ThreadAffinity::parseCoreList(config.getInferCores()),
+                           ThreadAffinity::parseCoreList(config.getTrackCores()),
+                           ThreadAffinity::parseCoreList(config.getOutputCores()));
+    
+    pipeline.setCaptureStage([&readFrame](FramePacket& packet) {
+        if (!readFrame(packet.frame, &packet.captureTime)) {
+            std::cout << "Video ended or cannot read frame" << std::endl;
+            return false;
+        }
+        return true;
+    });
+    
+    // 检测线程逐帧同步推理，与采集、跟踪、显示并行
+    pipeline.setInferStage([&](FramePacket& packet) {
+        AllocationScope detectAllocations(AllocationTracker::DetectStage);
+        auto inferStart = std::chrono::high_resolution_clock::now();
+        detector.detect(packet.frame, detections, config.getDetectColor());
+        packet.inferenceTime = std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - inferStart).count();
+        recordDetectorTiming(performanceMonitor, detector.getLastTiming(), packet.stageTimes);
+        
+        auto nmsStart = std::chrono::high_resolution_clock::now();
+        AllocationScope nmsAllocations(AllocationTracker::NMSStage);
+        packet.detections = imageProcessor.scaleResultsToOriginal(
+            applyNMSToDetections(imageProcessor, detections, config), packet.frame.size(), detector.getInputSize());
+        recordFrameStage(performanceMonitor, packet.stageTimes, PerformanceMonitor::NMSStage, millisecondsSince(nmsStart));
+    });
+    
+    // 队列按帧序传递，跟踪器看到的帧序与视频一致
+    pipeline.setTrackStage([&tracker, &performanceMonitor](FramePacket& packet) {
+        auto trackStart = std::chrono::high_resolution_clock::now();
+        packet.tracks = trackDetections(tracker, packet.detections);
+        recordFrameStage(performanceMonitor, packet.stageTimes, PerformanceMonitor::TrackStage, millisecondsSince(trackStart));
+    });
+    
+    pipeline.run([&](FramePacket& packet) {
+        // 记录首个有效检测结果的时间
+        if (!packet.detections.empty()) {
+            performanceMonitor.recordFirstDetectionTime(millisecondsSince(programStart));
+        }
+        performanceMonitor.recordInferenceTime(packet.inferenceTime);
+        performanceMonitor.incrementFrameCount();
+        
+        // 采集时间戳随帧经过检测、NMS和跟踪，到这里即得到该帧的端到端延迟
+        double latency = millisecondsSinceCapture(packet.captureTime);
+        performanceMonitor.recordLatency(latency);
+        performanceMonitor.recordFrameDeadline(latency, packet.stageTimes);
+        
+        if (resultSink.isOpen()) {
+            resultSink.write(outputFrames, millisecondsSince(programStart), latency, packet.detections, packet.tracks);
+        }
+        outputFrames++;
+        
+        // 显示阶段与检测并行，绘制耗时不从墙钟时间中扣除（见setRenderOverlapped）
+#if !defined(DETECTION_HEADLESS)
+        if (!headless) {
+            auto renderStart = std::chrono::high_resolution_clock::now();
+            bool keepRunning = displayResult(visualizer, framePool, packet.frame, packet.detections, packet.tracks,
+                                             performanceMonitor.getWallClockFPS(), packet.inferenceTime, latency,
+                                             performanceMonitor.getDeadlineStats());
+            performanceMonitor.recordRenderTime(millisecondsSince(renderStart));
+            return keepRunning;
+        }
+#endif
+        return true;
+    });
+    
+    pipeline.printStatistics();
+}
+
+int main(int argc, char** argv) {
     try {
+        auto programStart = std::chrono::high_resolution_clock::now();
+        
         // ==================== 初始化配置 ====================
         Config config;
         
+        // 可通过命令行参数指定配置文件
+        if (argc > 1 && !config.loadFromFile(argv[1])) {
+            return -1;
+        }
+        
         // config.printConfig();
         
+        // ==================== 线程配置 ====================
+        // OpenCV线程池与OpenVINO推理线程共用核心时会互相抢占，可在此限制
+        if (config.getOpenCVThreads() >= 0) {
+            cv::setNumThreads(config.getOpenCVThreads());
+        }
+        // 核心列表在加载模型前解析，格式错误时尽早报错
+        const std::vector<int> captureCores = ThreadAffinity::parseCoreList(config.getCaptureCores());
+        const std::vector<int> outputCores = ThreadAffinity::parseCoreList(config.getOutputCores());
+        
+        // ==================== 图像缓冲池 ====================
+        // 采集帧和显示副本从池中分配，帧在所有阶段（包括检测器的在途请求）都释放后回池；
+        // 必须先于所有持有帧的对象构造，最后析构
+        FramePool framePool(static_cast<size_t>(std::max(0, config.getFramePoolSize())));
+        
         // ==================== 初始化检测器 ====================
-        Detector detector(config.getModelPath(), config.getDevice());
+        DetectorOptions detectorOptions;
+        detectorOptions.numInferRequests = config.getNumInferRequests();
+        detectorOptions.useModelPreprocess = config.getUseModelPreprocess();
+        detectorOptions.confidenceThreshold = config.getConfidenceThreshold();
+        detectorOptions.performanceMode = config.getPerformanceMode();
+        detectorOptions.batchSize = config.getBatchSize();
+        detectorOptions.cacheDir = config.getCacheDir();
+        detectorOptions.inferencePrecision = config.getInferencePrecision();
+        detectorOptions.inferenceNumThreads = config.getInferenceNumThreads();
+        detectorOptions.numStreams = config.getNumStreams();
+        detectorOptions.cpuPinning = config.getCpuPinning();
+        detectorOptions.hyperThreading = config.getHyperThreading();
+        detectorOptions.enableProfiling = config.getEnableProfiling();
+        // ROI模式把各跟踪目标的ROI合并为一批推理，批大小为1时多于一个目标就只能退回全图检测
+        if (config.getRoiMode() && detectorOptions.batchSize <= 1) {
+            detectorOptions.batchSize = kRoiBatchSize;
+            std::cout << "ROI mode: batch_size raised to " << kRoiBatchSize
+                      << " so tracked ROIs share one inference" << std::endl;
+        }
+        Detector detector(config.getModelPathForPrecision(config.getInferencePrecision()), config.getDevice(), detectorOptions);
+        
+        // ==================== 运行方式 ====================
+        // 编译时定义DETECTION_HEADLESS时强制无界面，绘制和显示代码不参与编译
+#if defined(DETECTION_HEADLESS)
+        const bool headless = true;
+#else
+        const bool headless = config.getHeadless();
+#endif
+        ResultSink resultSink;
+        if (!config.getResultOutputPath().empty() && !resultSink.open(config.getResultOutputPath())) {
+            return -1;
+        }
+        if (headless) {
+            std::cout << "Headless mode: rendering and display disabled" << std::endl;
+        }
         
         // ==================== 预处理 =========================
         ImageProcessor imageProcessor;
         Visualizer visualizer;
         PerformanceMonitor performanceMonitor;
+        performanceMonitor.setFrameDeadline(config.getFrameDeadlineMs());
         
         // ==================== 初始化BYTETracker跟踪器 ====================
         BYTETracker tracker(60, 60); // 帧率30fps，跟踪缓冲区30帧
@@ -39,101 +284,237 @@ int main() {
             return -1;
         }
         
+        // ==================== 追踪事件 ====================
+        // 从预热开始记录各线程、各阶段的区间，用于定位偶发的长帧
+        if (!config.getTraceOutputPath().empty()) {
+            if (!TraceRecorder::start(config.getTraceOutputPath())) {
+                return -1;
+            }
+            TraceRecorder::setThreadName("main");
+        }
+        
+        // ==================== 预热 ====================
+        // 启动耗时与预热耗时分开统计
+        performanceMonitor.recordStartupTime(detector.getLoadTime());
+        if (config.getWarmupIterations() > 0) {
+            cv::Size videoSize(static_cast<int>(cap.get(cv::CAP_PROP_FRAME_WIDTH)),
+                               static_cast<int>(cap.get(cv::CAP_PROP_FRAME_HEIGHT)));
+            performanceMonitor.recordWarmupTime(detector.warmup(config.getWarmupIterations(), videoSize));
+        }
+        
+        // ==================== 采集方式 ====================
+        // LATEST模式由后台线程持续采集到单帧邮箱，每次只处理最新帧，来不及处理的帧计为丢帧；
+        // 录像文件（有总帧数）按其帧率节流以模拟相机，相机本身按采集帧率阻塞，无需节流
+        // 各线程在模型编译和预热之后才绑核，避免OpenVINO在绑核线程中创建的推理线程继承亲和性
+        const bool latestFrameMode = config.getCaptureMode() == "LATEST";
+        const bool isVideoFile = cap.get(cv::CAP_PROP_FRAME_COUNT) > 0;
+        LatestFrameGrabber grabber(cap, isVideoFile ? cap.get(cv::CAP_PROP_FPS) : 0.0, &framePool);
+        grabber.setCores(captureCores);
+        if (latestFrameMode) {
+            grabber.start();
+        }
+        FrameReader readFrame = [&](cv::Mat& frame, std::chrono::steady_clock::time_point* grabTime) {
+            AllocationScope allocationScope(AllocationTracker::CaptureStage);
+            if (latestFrameMode) {
+                return grabber.read(frame, grabTime);
+            }
+            // VideoCapture解码后经create写入frame，挂到缓冲池后复用已回池的缓冲区
+            // LATEST模式的解码在采集线程中进行，不计入decode阶段
+            framePool.attach(frame);
+            auto decodeStart = std::chrono::high_resolution_clock::now();
+            TraceZone zone("decode");
+            if (!cap.read(frame)) return false;
+            performanceMonitor.recordStageTime(PerformanceMonitor::DecodeStage, millisecondsSince(decodeStart));
+            if (grabTime) *grabTime = std::chrono::steady_clock::now();
+            return true;
+        };
+        
         // ==================== 开始性能监控 ====================
+        // 分配计数从这里开始，不含模型加载和预热
+        AllocationTracker::reset();
         performanceMonitor.start();
         
         // ==================== 主处理循环 ====================
-        while (true) {
-            cv::Mat frame;
-            
-            // 读取视频帧
-            if (!cap.read(frame)) {
-                std::cout << "Video ended or cannot read frame" << std::endl;
-                break;
-            }
-            
-            // 记录推理开始时间
-            auto inferStart = std::chrono::high_resolution_clock::now();
-            
-            // ==================== 执行检测 ====================
-            std::vector<DetectionResult> detections = detector.detect(frame, config.getDetectColor());
-            
-            // 记录推理结束时间
-            auto inferEnd = std::chrono::high_resolution_clock::now();
-            double inferenceTime = std::chrono::duration<double, std::milli>(inferEnd - inferStart).count();
-            
-            // ==================== 应用NMS ====================
-            std::vector<cv::Rect> boxes;
-            std::vector<float> confidences;
-            
-            for (const auto& detection : detections) {
-                boxes.push_back(detection.boundingBox);
-                confidences.push_back(detection.confidence);
-            }
-            
-            std::vector<int> indices = imageProcessor.applyNMS(boxes, confidences, 
-                                                              config.getConfidenceThreshold(), 
-                                                              config.getNMSThreshold());
-            
-            // ==================== 筛选检测结果 ====================
-            std::vector<DetectionResult> filteredDetections;
-            for (int idx : indices) {
-                filteredDetections.push_back(detections[idx]);
+        // ROI模式依赖上一帧的跟踪结果，只能在单线程循环中运行
+        if (config.getThreadedPipeline() && !config.getRoiMode()) {
+            runThreadedPipeline(config, readFrame, latestFrameMode, detector, imageProcessor,
+                                visualizer, performanceMonitor, tracker, resultSink, framePool, headless, programStart);
+        } else {
+            // 单线程循环中主线程完成检测、跟踪和输出，绑定到输出核心
+            if (!ThreadAffinity::pinCurrentThread(outputCores)) {
+                std::cerr << "Cannot pin main thread to cores " << ThreadAffinity::formatCoreList(outputCores) << std::endl;
             }
+            FrameResult frameResult;
+            bool videoEnded = false;
+            long long frameCount = 0;
+            std::vector<STrack> tracks;
             
-            // ==================== 调整结果到原始尺寸 ====================
-            cv::Size originalSize = frame.size();
-            cv::Size processedSize = detector.getInputSize();
-            std::vector<DetectionResult> scaledDetections = imageProcessor.scaleResultsToOriginal(
-                filteredDetections, originalSize, processedSize);
+            // ROI模式使用的复用容器
+            std::vector<DetectionResult> detections;
+            std::vector<cv::Rect> rois;
+            std::vector<cv::Mat> roiFrames;
+            std::vector<std::vector<DetectionResult>> roiResults;
             
-            // ==================== 转换为BYTETracker需要的Object格式 ====================
-            std::vector<Object> objects;
-            for (const auto& detection : scaledDetections) {
-                Object obj;
-                obj.rect = detection.boundingBox;
-                obj.label = detection.classId;
-                obj.prob = detection.confidence;
-                objects.push_back(obj);
+            while (true) {
+                TraceZone frameZone("frame", frameCount);
+                cv::Mat frame;
+                std::chrono::steady_clock::time_point captureTime;
+                
+                // 读取视频帧
+                if (!videoEnded && !readFrame(frame, &captureTime)) {
+                    std::cout << "Video ended or cannot read frame" << std::endl;
+                    videoEnded = true;
+                }
+                
+                // 记录推理开始时间
+                auto inferStart = std::chrono::high_resolution_clock::now();
+                double inferenceTime = 0.0;
+                PerformanceMonitor::FrameStageTimes stageTimes{};
+                cv::Mat resultFrame;
+                std::chrono::steady_clock::time_point resultCaptureTime;
+                std::vector<DetectionResult> scaledDetections;
+                
+                // ==================== 执行检测 ====================
+                if (config.getRoiMode()) {
+                    // ROI模式依赖上一帧的跟踪结果，逐帧同步检测
+                    if (videoEnded) break;
+                    AllocationScope detectAllocations(AllocationTracker::DetectStage);
+                    resultFrame = frame;
+                    resultCaptureTime = captureTime;
+                    
+                    // 定期或无法用ROI覆盖全部目标时做全图检测，以发现新目标
+                    bool fullFrame = frameCount % std::max(1, config.getRoiFullFrameInterval()) == 0 ||
+                                     !imageProcessor.computeTrackROIs(tracks, frame.size(), detector.getInputSize(),
+                                                                      config.getRoiMargin(), rois) ||
+                                     static_cast<int>(rois.size()) > detector.getBatchSize();
+                    
+                    if (fullFrame) {
+                        detector.detect(frame, detections, config.getDetectColor());
+                        inferenceTime = std::chrono::duration<double, std::milli>(
+                            std::chrono::high_resolution_clock::now() - inferStart).count();
+                        recordDetectorTiming(performanceMonitor, detector.getLastTiming(), stageTimes);
+                        auto nmsStart = std::chrono::high_resolution_clock::now();
+                        AllocationScope nmsAllocations(AllocationTracker::NMSStage);
+                        scaledDetections = imageProcessor.scaleResultsToOriginal(
+                            applyNMSToDetections(imageProcessor, detections, config), frame.size(), detector.getInputSize());
+                        recordFrameStage(performanceMonitor, stageTimes, PerformanceMonitor::NMSStage, millisecondsSince(nmsStart));
+                    } else {
+                        // 高分辨率ROI合并为一批推理，结果映射回全图坐标后统一做NMS
+                        roiFrames.clear();
+                        for (const auto& roi : rois) {
+                            roiFrames.push_back(frame(roi));
+                        }
+                        detector.detectBatch(roiFrames, roiResults, config.getDetectColor());
+                        inferenceTime = std::chrono::duration<double, std::milli>(
+                            std::chrono::high_resolution_clock::now() - inferStart).count();
+                        
+                        detections.clear();
+                        for (size_t i = 0; i < rois.size(); ++i) {
+                            imageProcessor.mapROIResultsToFrame(roiResults[i], rois[i], detector.getInputSize(), detections);
+                        }
+                        auto nmsStart = std::chrono::high_resolution_clock::now();
+                        AllocationScope nmsAllocations(AllocationTracker::NMSStage);
+                        scaledDetections = applyNMSToDetections(imageProcessor, detections, config);
+                        recordFrameStage(performanceMonitor, stageTimes, PerformanceMonitor::NMSStage, millisecondsSince(nmsStart));
+                    }
+                } else {
+                    AllocationScope detectAllocations(AllocationTracker::DetectStage);
+                    // 流水线模式下返回的是较早提交帧的结果；视频结束后依次取出剩余帧
+                    bool hasResult = videoEnded ? detector.flushPipeline(frameResult)
+                                                : detector.detectPipelined(frame, config.getDetectColor(), frameResult, captureTime);
+                    if (videoEnded && !hasResult) break;
+                    if (!hasResult) continue;
+                    
+                    // 记录推理结束时间
+                    auto inferEnd = std::chrono::high_resolution_clock::now();
+                    inferenceTime = std::chrono::duration<double, std::milli>(inferEnd - inferStart).count();
+                    resultFrame = frameResult.frame;
+                    resultCaptureTime = frameResult.captureTime;
+                    recordDetectorTiming(performanceMonitor, detector.getLastTiming(), stageTimes);
+                    
+                    // ==================== 应用NMS并调整结果到原始尺寸 ====================
+                    auto nmsStart = std::chrono::high_resolution_clock::now();
+                    AllocationScope nmsAllocations(AllocationTracker::NMSStage);
+                    scaledDetections = imageProcessor.scaleResultsToOriginal(
+                        applyNMSToDetections(imageProcessor, frameResult.detections, config),
+                        resultFrame.size(), detector.getInputSize());
+                    recordFrameStage(performanceMonitor, stageTimes, PerformanceMonitor::NMSStage, millisecondsSince(nmsStart));
+                }
+                frameCount++;
+                
+                // 记录首个有效检测结果的时间
+                if (!scaledDetections.empty()) {
+                    performanceMonitor.recordFirstDetectionTime(millisecondsSince(programStart));
+                }
+                
+                // ==================== 执行跟踪 ====================
+                // 多个推理请求可能乱序完成，但流水线按提交顺序（frameIndex递增）输出，跟踪器看到的帧序与视频一致
+                auto trackStart = std::chrono::high_resolution_clock::now();
+                tracks = trackDetections(tracker, scaledDetections);
+                recordFrameStage(performanceMonitor, stageTimes, PerformanceMonitor::TrackStage, millisecondsSince(trackStart));
+                
+                // ==================== 更新性能统计 ====================
+                performanceMonitor.recordInferenceTime(inferenceTime);
+                performanceMonitor.incrementFrameCount();
+                
+                // 异步流水线下结果对应较早提交的帧，延迟按该帧自己的采集时间计算
+                double latency = millisecondsSinceCapture(resultCaptureTime);
+                performanceMonitor.recordLatency(latency);
+                performanceMonitor.recordFrameDeadline(latency, stageTimes);
+                
+                // ==================== 输出结构化结果 ====================
+                if (resultSink.isOpen()) {
+                    resultSink.write(frameCount - 1, millisecondsSince(programStart), latency, scaledDetections, tracks);
+                }
+                
+                // ==================== 可视化并显示结果 ====================
+#if !defined(DETECTION_HEADLESS)
+                if (!headless) {
+                    auto renderStart = std::chrono::high_resolution_clock::now();
+                    bool keepRunning = displayResult(visualizer, framePool, resultFrame, scaledDetections, tracks,
+                                                     performanceMonitor.getWallClockFPS(), inferenceTime, latency,
+                                                     performanceMonitor.getDeadlineStats());
+                    performanceMonitor.recordRenderTime(millisecondsSince(renderStart));
+                    if (!keepRunning) break;
+                }
+#endif
             }
-            
-            // ==================== 执行跟踪 ====================
-            std::vector<STrack> tracks = tracker.update(objects);
-            
-            // ==================== 可视化结果 ====================
-            cv::Mat displayFrame = frame.clone();
-            
-            // 绘制检测结果
-            visualizer.drawDetections(displayFrame, scaledDetections);
-            
-            // 绘制跟踪结果
-            visualizer.drawTracks(displayFrame, tracks);
-            
-            // 计算并绘制性能信息
-            double fps = 1000.0 / inferenceTime;
-            visualizer.drawPerformanceInfo(displayFrame, fps, inferenceTime);
-            
-            // ==================== 更新性能统计 ====================
-            performanceMonitor.recordInferenceTime(inferenceTime);
-            performanceMonitor.incrementFrameCount();
-            
-            // ==================== 显示结果 ====================
-            cv::imshow("OpenVINO Detection Result", displayFrame);
-        
-            
-            // 检查按键：按'q'退出
-            if (cv::waitKey(1) == 'q') break;
         }
         
         // ==================== 程序结束处理 ====================
         performanceMonitor.end();
         
         // 释放资源
+        grabber.stop();
         cap.release();
-        cv::destroyAllWindows();
+        resultSink.close();
+        if (TraceRecorder::isEnabled()) {
+            TraceRecorder::stop();
+            std::cout << "Trace written to " << config.getTraceOutputPath() << " (dropped events: "
+                      << TraceRecorder::getDroppedEvents() << ")" << std::endl;
+        }
+#if !defined(DETECTION_HEADLESS)
+        if (!headless) {
+            cv::destroyAllWindows();
+        }
+#endif
         
         // ==================== 输出性能统计 ====================
         performanceMonitor.printStatistics();
+        if (detector.isProfilingEnabled()) {
+            performanceMonitor.printLayerProfiles(detector.getLayerProfiles(), config.getProfilingTopN());
+            if (!config.getProfilingCsvPath().empty() &&
+                performanceMonitor.writeLayerProfilesCsv(detector.getLayerProfiles(), config.getProfilingCsvPath())) {
+                std::cout << "Layer profile written to " << config.getProfilingCsvPath() << std::endl;
+            }
+        }
+        if (latestFrameMode) {
+            grabber.printStatistics();
+        }
+        if (framePool.isEnabled()) {
+            framePool.printStatistics();
+        }
+        AllocationTracker::printStatistics(performanceMonitor.getTotalFrames());
         
         return 0;
     }
@@ -0,0 +1,129 @@
+#include <iostream>
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// 包含自定义模块头文件
+#include "../include/Config.h"
+#include "../include/Detector.h"
+#include "../include/Visualizer.h"
+#include "../include/FramePool.h"
+#include "../include/StreamScheduler.h"
+
+// 包含BYTETracker相关头文件
+#include "../ncnn/cpp/include/STrack.h"
+
+// 多路视频流检测：一个进程处理多路相机/录像，共享一个编译模型和推理请求池
+//
+// 用法：multi_stream_main 配置文件1 [配置文件2 ...]
+//   每个配置文件对应一路流，提供该路的video_path、detect_color、置信度/NMS阈值和nms_mode；
+//   模型、设备、推理请求数量、性能模式等检测器参数以及headless、frame_pool_size取第一个配置文件
+
+int main(int argc, char** argv) {
+    try {
+        if (argc < 2) {
+            std::cerr << "Usage: multi_stream_main <config1> [config2 ...]" << std::endl;
+            return -1;
+        }
+
+        // ==================== 加载各路配置 ====================
+        std::vector<Config> configs(argc - 1);
+        for (int i = 1; i < argc; ++i) {
+            if (!configs[i - 1].loadFromFile(argv[i])) {
+                return -1;
+            }
+        }
+        const Config& mainConfig = configs.front();
+
+        // ==================== 图像缓冲池 ====================
+        // 必须先于检测器和调度器构造，最后析构
+        FramePool framePool(static_cast<size_t>(std::max(0, mainConfig.getFramePoolSize())));
+
+        // ==================== 初始化共享检测器 ====================
+        // 检测器按各路中最低的置信度阈值预筛选，各路再按自己的阈值做NMS
+        float minConfidence = mainConfig.getConfidenceThreshold();
+        for (const auto& config : configs) {
+            minConfidence = std::min(minConfidence, config.getConfidenceThreshold());
+        }
+        DetectorOptions detectorOptions;
+        detectorOptions.numInferRequests = mainConfig.getNumInferRequests();
+        detectorOptions.useModelPreprocess = mainConfig.getUseModelPreprocess();
+        detectorOptions.confidenceThreshold = minConfidence;
+        detectorOptions.performanceMode = mainConfig.getPerformanceMode();
+        detectorOptions.cacheDir = mainConfig.getCacheDir();
+        detectorOptions.inferencePrecision = mainConfig.getInferencePrecision();
+        detectorOptions.inferenceNumThreads = mainConfig.getInferenceNumThreads();
+        detectorOptions.numStreams = mainConfig.getNumStreams();
+        detectorOptions.cpuPinning = mainConfig.getCpuPinning();
+        detectorOptions.hyperThreading = mainConfig.getHyperThreading();
+        detectorOptions.enableProfiling = mainConfig.getEnableProfiling();
+        Detector detector(mainConfig.getModelPathForPrecision(mainConfig.getInferencePrecision()),
+                          mainConfig.getDevice(), detectorOptions);
+        if (detector.getPipelineDepth() < static_cast<int>(configs.size())) {
+            std::cout << "Note: " << detector.getPipelineDepth() << " infer requests for " << configs.size()
+                      << " streams, streams will take turns (num_infer_requests=0 uses the device recommendation)" << std::endl;
+        }
+
+        // ==================== 添加视频流 ====================
+        StreamScheduler scheduler(detector, &framePool);
+        for (size_t i = 0; i < configs.size(); ++i) {
+            scheduler.addStream(configs[i], "Stream " + std::to_string(i));
+        }
+
+        // ==================== 预热 ====================
+        if (mainConfig.getWarmupIterations() > 0) {
+            detector.warmup(mainConfig.getWarmupIterations(), scheduler.getFrameSize(0));
+        }
+
+        // ==================== 运行方式 ====================
+#if defined(DETECTION_HEADLESS)
+        const bool headless = true;
+#else
+        const bool headless = mainConfig.getHeadless();
+#endif
+        Visualizer visualizer;
+
+        // ==================== 调度各路流 ====================
+        scheduler.run([&](int streamIndex, const cv::Mat& frame,
+                          const std::vector<DetectionResult>& detections,
+                          const std::vector<STrack>& tracks,
+                          double latencyMs) {
+#if !defined(DETECTION_HEADLESS)
+            if (!headless) {
+                // 每路一个窗口，副本从缓冲池分配
+                cv::Mat displayFrame;
+                framePool.attach(displayFrame);
+                frame.copyTo(displayFrame);
+                visualizer.drawDetections(displayFrame, detections);
+                visualizer.drawTracks(displayFrame, tracks);
+                visualizer.drawPerformanceInfo(displayFrame, scheduler.getStreamStats(streamIndex).fps,
+                                               detector.getLastTiming().inferMs, latencyMs);
+                cv::imshow("Stream " + std::to_string(streamIndex), displayFrame);
+
+                // 检查按键：按'q'退出
+                return cv::waitKey(1) != 'q';
+            }
+#endif
+            return true;
+        });
+
+#if !defined(DETECTION_HEADLESS)
+        if (!headless) {
+            cv::destroyAllWindows();
+        }
+#endif
+
+        // ==================== 输出性能统计 ====================
+        scheduler.printStatistics();
+        if (framePool.isEnabled()) {
+            framePool.printStatistics();
+        }
+
+        return 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Program execution error: " << e.what() << std::endl;
+        return -1;
+    }
+}
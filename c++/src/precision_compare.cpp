@@ -0,0 +1,218 @@
+#include <iostream>
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// 包含自定义模块头文件
+#include "../include/Config.h"
+#include "../include/Detector.h"
+#include "../include/ImageProcessor.h"
+#include "../include/PerformanceMonitor.h"
+
+// 推理精度对比工具：用同一段录像依次运行各精度的模型，
+// 以第一个精度为基准统计逐帧延迟和检测结果一致性
+//
+// 用法：precision_compare [配置文件] [精度1 精度2 ...]
+//   默认对比 FP32 BF16 INT8，FP32为基准
+
+// 单个精度变体的运行结果
+struct VariantRun {
+    std::string precision;                                  // 精度名称
+    std::vector<double> latencies;                          // 逐帧检测耗时（毫秒）
+    std::vector<std::vector<DetectionResult>> frames;       // 逐帧检测结果（原始图像坐标）
+};
+
+// 与基准的一致性统计
+struct AgreementStats {
+    int referenceCount = 0;                                 // 基准检测数量
+    int matchedCount = 0;                                   // 匹配成功数量
+    int extraCount = 0;                                     // 变体多出的检测数量
+    int classAgreeCount = 0;                                // 类别一致数量
+    int colorAgreeCount = 0;                                // 颜色一致数量
+    double iouSum = 0.0;                                    // 匹配对的IoU之和
+    double landmarkErrorSum = 0.0;                          // 匹配对的关键点平均像素误差之和
+    double landmarkErrorMax = 0.0;                          // 关键点平均像素误差最大值
+};
+
+// 计算两个边界框的IoU
+static double boxIoU(const cv::Rect& a, const cv::Rect& b) {
+    double inter = (a & b).area();
+    double uni = a.area() + b.area() - inter;
+    return uni > 0 ? inter / uni : 0.0;
+}
+
+// 计算四个关键点的平均像素误差
+static double landmarkError(const DetectionResult& a, const DetectionResult& b) {
+    double sum = 0.0;
+    for (size_t i = 0; i < a.landmarks.size(); ++i) {
+        sum += cv::norm(a.landmarks[i] - b.landmarks[i]);
+    }
+    return sum / a.landmarks.size();
+}
+
+// 运行一个精度变体
+static VariantRun runVariant(const Config& config, const std::string& precision) {
+    VariantRun run;
+    run.precision = precision;
+
+    DetectorOptions options;
+    options.confidenceThreshold = config.getConfidenceThreshold();
+    options.inferencePrecision = precision;
+    options.useModelPreprocess = config.getUseModelPreprocess();
+    options.cacheDir = config.getCacheDir();
+    Detector detector(config.getModelPathForPrecision(precision), config.getDevice(), options);
+    ImageProcessor imageProcessor;
+
+    cv::VideoCapture cap(config.getVideoPath());
+    if (!cap.isOpened()) {
+        throw std::runtime_error("Cannot open video file: " + config.getVideoPath());
+    }
+
+    // 预热，避免首帧耗时计入统计
+    cv::Size videoSize(static_cast<int>(cap.get(cv::CAP_PROP_FRAME_WIDTH)),
+                       static_cast<int>(cap.get(cv::CAP_PROP_FRAME_HEIGHT)));
+    detector.warmup(std::max(1, config.getWarmupIterations()), videoSize);
+
+    cv::Mat frame;
+    std::vector<DetectionResult> detections;
+    std::vector<DetectionResult> filtered;
+    while (cap.read(frame)) {
+        auto start = std::chrono::high_resolution_clock::now();
+        detector.detect(frame, detections, config.getDetectColor());
+        auto end = std::chrono::high_resolution_clock::now();
+        run.latencies.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+
+        // 与主程序一致：按nms_mode做NMS后缩放到原始图像尺寸
+        imageProcessor.applyNMSByMode(detections, config.getConfidenceThreshold(), config.getNMSThreshold(),
+                                      config.getNMSMode(), config.getNMSMergeLandmarks(), filtered);
+        run.frames.push_back(imageProcessor.scaleResultsToOriginal(filtered, frame.size(), detector.getInputSize()));
+    }
+
+    std::cout << precision << ": processed " << run.frames.size() << " frames" << std::endl;
+    return run;
+}
+
+// 将变体结果与基准逐帧贪心匹配（IoU >= 0.5）
+static AgreementStats compareRuns(const VariantRun& reference, const VariantRun& variant) {
+    AgreementStats stats;
+    size_t numFrames = std::min(reference.frames.size(), variant.frames.size());
+
+    for (size_t f = 0; f < numFrames; ++f) {
+        const auto& refDets = reference.frames[f];
+        const auto& varDets = variant.frames[f];
+        std::vector<bool> used(varDets.size(), false);
+        stats.referenceCount += static_cast<int>(refDets.size());
+
+        for (const auto& ref : refDets) {
+            int best = -1;
+            double bestIoU = 0.5;
+            for (size_t j = 0; j < varDets.size(); ++j) {
+                if (used[j]) continue;
+                double iou = boxIoU(ref.boundingBox, varDets[j].boundingBox);
+                if (iou >= bestIoU) {
+                    bestIoU = iou;
+                    best = static_cast<int>(j);
+                }
+            }
+            if (best < 0) continue;
+
+            used[best] = true;
+            const auto& match = varDets[best];
+            double error = landmarkError(ref, match);
+            stats.matchedCount++;
+            stats.iouSum += bestIoU;
+            stats.landmarkErrorSum += error;
+            stats.landmarkErrorMax = std::max(stats.landmarkErrorMax, error);
+            if (match.classId == ref.classId) stats.classAgreeCount++;
+            if (match.colorId == ref.colorId) stats.colorAgreeCount++;
+        }
+        stats.extraCount += static_cast<int>(std::count(used.begin(), used.end(), false));
+    }
+    return stats;
+}
+
+int main(int argc, char** argv) {
+    try {
+        Config config;
+        if (argc > 1 && !config.loadFromFile(argv[1])) {
+            return -1;
+        }
+
+        std::vector<std::string> precisions;
+        for (int i = 2; i < argc; ++i) {
+            precisions.push_back(argv[i]);
+        }
+        if (precisions.empty()) {
+            precisions = {"FP32", "BF16", "INT8"};
+        }
+
+        // ==================== 依次运行各精度 ====================
+        std::vector<VariantRun> runs;
+        for (const auto& precision : precisions) {
+            try {
+                runs.push_back(runVariant(config, precision));
+            }
+            catch (const std::exception& e) {
+                std::cerr << "Skipping " << precision << ": " << e.what() << std::endl;
+            }
+        }
+        if (runs.empty()) {
+            std::cerr << "No variant could be run" << std::endl;
+            return -1;
+        }
+
+        // ==================== 输出对比报告 ====================
+        const VariantRun& reference = runs.front();
+        std::cout << "\n=== Precision Comparison (reference: " << reference.precision << ") ===" << std::endl;
+        std::cout << std::left << std::setw(8) << "Variant"
+                  << std::right << std::setw(10) << "Mean ms"
+                  << std::setw(10) << "P50 ms"
+                  << std::setw(10) << "P95 ms"
+                  << std::setw(10) << "Max ms"
+                  << std::setw(10) << "Recall"
+                  << std::setw(8) << "Extra"
+                  << std::setw(10) << "Mean IoU"
+                  << std::setw(12) << "LM err px"
+                  << std::setw(12) << "LM max px"
+                  << std::setw(9) << "Class"
+                  << std::setw(9) << "Color" << std::endl;
+
+        for (const auto& run : runs) {
+            AgreementStats stats = compareRuns(reference, run);
+            double mean = 0.0;
+            for (double t : run.latencies) mean += t;
+            mean = run.latencies.empty() ? 0.0 : mean / run.latencies.size();
+            std::vector<double> sortedLatencies = run.latencies;
+            std::sort(sortedLatencies.begin(), sortedLatencies.end());
+            double matched = std::max(1, stats.matchedCount);
+
+            std::cout << std::left << std::setw(8) << run.precision << std::right << std::fixed
+                      << std::setprecision(2)
+                      << std::setw(10) << mean
+                      << std::setw(10) << PerformanceMonitor::percentileOfSorted(sortedLatencies, 50)
+                      << std::setw(10) << PerformanceMonitor::percentileOfSorted(sortedLatencies, 95)
+                      << std::setw(10) << PerformanceMonitor::percentileOfSorted(sortedLatencies, 100)
+                      << std::setprecision(3)
+                      << std::setw(10) << (stats.referenceCount > 0 ? static_cast<double>(stats.matchedCount) / stats.referenceCount : 1.0)
+                      << std::setw(8) << stats.extraCount
+                      << std::setw(10) << stats.iouSum / matched
+                      << std::setprecision(2)
+                      << std::setw(12) << stats.landmarkErrorSum / matched
+                      << std::setw(12) << stats.landmarkErrorMax
+                      << std::setprecision(3)
+                      << std::setw(9) << stats.classAgreeCount / matched
+                      << std::setw(9) << stats.colorAgreeCount / matched << std::endl;
+        }
+        std::cout << "Recall/IoU/landmark error/class/color agreement are measured against matched reference detections (IoU >= 0.5)." << std::endl;
+
+        return 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Program execution error: " << e.what() << std::endl;
+        return -1;
+    }
+}
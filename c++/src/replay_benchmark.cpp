@@ -0,0 +1,240 @@
+#include <iostream>
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// 包含自定义模块头文件
+#include "../include/Config.h"
+#include "../include/Detector.h"
+#include "../include/ImageProcessor.h"
+#include "../include/PerformanceMonitor.h"
+
+// 包含BYTETracker相关头文件
+#include "../ncnn/cpp/include/BYTETracker.h"
+#include "../ncnn/cpp/include/STrack.h"
+
+// 内存回放基准测试：计时开始前把录像全部解码到内存，
+// 再对同一组帧重复运行 预处理 -> 推理 -> 后处理 -> NMS -> 坐标缩放 -> 跟踪，
+// 排除视频解码的干扰，按阶段输出JSON统计，便于不同优化之间在相同条件下对比
+//
+// 用法：replay_benchmark [配置文件] [回放次数] [JSON输出文件] [最多解码帧数]
+//   回放次数默认3；JSON默认写入replay_benchmark.json；最多解码帧数为0时解码整个录像
+
+// 单个阶段的逐帧耗时
+struct StageSamples {
+    std::string name;                   // 阶段名称
+    std::vector<double> samples;        // 逐帧耗时（毫秒）
+};
+
+// 从start到现在经过的毫秒数
+static double millisecondsSince(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+// 转义JSON字符串中的反斜杠和引号（Windows路径）
+static std::string jsonEscape(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '\\' || c == '"') escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+
+// 输出一个阶段的JSON统计
+static void writeStageJson(FILE* out, const StageSamples& stage, bool last) {
+    std::vector<double> sorted = stage.samples;
+    std::sort(sorted.begin(), sorted.end());
+    double total = 0.0;
+    for (double t : sorted) total += t;
+    double mean = sorted.empty() ? 0.0 : total / sorted.size();
+
+    std::fprintf(out, "    \"%s\": {\"count\": %zu, \"total_ms\": %.3f, \"mean_ms\": %.4f, \"min_ms\": %.4f, "
+                      "\"p50_ms\": %.4f, \"p95_ms\": %.4f, \"p99_ms\": %.4f, \"max_ms\": %.4f}%s\n",
+                 stage.name.c_str(), sorted.size(), total, mean,
+                 sorted.empty() ? 0.0 : sorted.front(),
+                 PerformanceMonitor::percentileOfSorted(sorted, 50), PerformanceMonitor::percentileOfSorted(sorted, 95),
+                 PerformanceMonitor::percentileOfSorted(sorted, 99),
+                 sorted.empty() ? 0.0 : sorted.back(),
+                 last ? "" : ",");
+}
+
+int main(int argc, char** argv) {
+    try {
+        Config config;
+        if (argc > 1 && !config.loadFromFile(argv[1])) {
+            return -1;
+        }
+        const int passes = argc > 2 ? std::max(1, std::stoi(argv[2])) : 3;
+        const std::string outputPath = argc > 3 ? argv[3] : "replay_benchmark.json";
+        const int maxFrames = argc > 4 ? std::max(0, std::stoi(argv[4])) : 0;
+
+        // ==================== 预解码到内存 ====================
+        cv::VideoCapture cap(config.getVideoPath());
+        if (!cap.isOpened()) {
+            std::cerr << "Cannot open video file: " << config.getVideoPath() << std::endl;
+            return -1;
+        }
+        auto decodeStart = std::chrono::high_resolution_clock::now();
+        std::vector<cv::Mat> frames;
+        size_t frameBytes = 0;
+        cv::Mat frame;
+        while ((maxFrames == 0 || static_cast<int>(frames.size()) < maxFrames) && cap.read(frame)) {
+            frameBytes += frame.total() * frame.elemSize();
+            frames.push_back(frame.clone());
+        }
+        double decodeMs = millisecondsSince(decodeStart);
+        cap.release();
+        if (frames.empty()) {
+            std::cerr << "No frames decoded from: " << config.getVideoPath() << std::endl;
+            return -1;
+        }
+        std::cout << "Decoded " << frames.size() << " frames (" << frameBytes / (1024.0 * 1024.0)
+                  << " MB) in " << decodeMs << " ms" << std::endl;
+
+        // ==================== 初始化检测器 ====================
+        // 逐帧同步检测，各阶段耗时互不重叠
+        DetectorOptions detectorOptions;
+        detectorOptions.numInferRequests = 1;
+        detectorOptions.useModelPreprocess = config.getUseModelPreprocess();
+        detectorOptions.confidenceThreshold = config.getConfidenceThreshold();
+        detectorOptions.performanceMode = config.getPerformanceMode();
+        detectorOptions.cacheDir = config.getCacheDir();
+        detectorOptions.inferencePrecision = config.getInferencePrecision();
+        detectorOptions.inferenceNumThreads = config.getInferenceNumThreads();
+        detectorOptions.numStreams = config.getNumStreams();
+        detectorOptions.cpuPinning = config.getCpuPinning();
+        detectorOptions.hyperThreading = config.getHyperThreading();
+        detectorOptions.enableProfiling = config.getEnableProfiling();
+        Detector detector(config.getModelPathForPrecision(config.getInferencePrecision()), config.getDevice(), detectorOptions);
+        if (config.getWarmupIterations() > 0) {
+            detector.warmup(config.getWarmupIterations(), frames.front().size());
+        }
+
+        ImageProcessor imageProcessor;
+        StageSamples preprocessStage{"preprocess", {}};
+        StageSamples inferStage{"infer", {}};
+        StageSamples postprocessStage{"postprocess", {}};
+        StageSamples nmsStage{"nms", {}};
+        StageSamples scaleStage{"scale", {}};
+        StageSamples trackStage{"track", {}};
+        StageSamples totalStage{"total", {}};
+        const size_t sampleCount = frames.size() * passes;
+        for (StageSamples* stage : {&preprocessStage, &inferStage, &postprocessStage, &nmsStage,
+                                    &scaleStage, &trackStage, &totalStage}) {
+            stage->samples.reserve(sampleCount);
+        }
+
+        // ==================== 回放 ====================
+        std::vector<DetectionResult> detections;
+        std::vector<DetectionResult> filteredDetections;
+        std::vector<Object> objects;
+        long long totalDetections = 0;
+        long long totalTracks = 0;
+        double replayMs = 0.0;
+
+        for (int pass = 0; pass < passes; ++pass) {
+            // 每次回放使用新的跟踪器，各次回放的工作量一致
+            BYTETracker tracker(60, 60);
+            auto passStart = std::chrono::high_resolution_clock::now();
+
+            for (const cv::Mat& replayFrame : frames) {
+                auto frameStart = std::chrono::high_resolution_clock::now();
+
+                // 预处理、推理和后处理，分项耗时由检测器记录
+                detector.detect(replayFrame, detections, config.getDetectColor());
+                const DetectorTiming& timing = detector.getLastTiming();
+
+                auto nmsStart = std::chrono::high_resolution_clock::now();
+                imageProcessor.applyNMSByMode(detections, config.getConfidenceThreshold(), config.getNMSThreshold(),
+                                              config.getNMSMode(), config.getNMSMergeLandmarks(), filteredDetections);
+
+                auto scaleStart = std::chrono::high_resolution_clock::now();
+                std::vector<DetectionResult> scaledDetections = imageProcessor.scaleResultsToOriginal(
+                    filteredDetections, replayFrame.size(), detector.getInputSize());
+
+                auto trackStart = std::chrono::high_resolution_clock::now();
+                objects.clear();
+                for (const auto& detection : scaledDetections) {
+                    Object obj;
+                    obj.rect = detection.boundingBox;
+                    obj.label = detection.classId;
+                    obj.prob = detection.confidence;
+                    objects.push_back(obj);
+                }
+                std::vector<STrack> tracks = tracker.update(objects);
+                auto frameEnd = std::chrono::high_resolution_clock::now();
+
+                preprocessStage.samples.push_back(timing.preprocessMs);
+                inferStage.samples.push_back(timing.inferMs);
+                postprocessStage.samples.push_back(timing.postprocessMs);
+                nmsStage.samples.push_back(std::chrono::duration<double, std::milli>(scaleStart - nmsStart).count());
+                scaleStage.samples.push_back(std::chrono::duration<double, std::milli>(trackStart - scaleStart).count());
+                trackStage.samples.push_back(std::chrono::duration<double, std::milli>(frameEnd - trackStart).count());
+                totalStage.samples.push_back(std::chrono::duration<double, std::milli>(frameEnd - frameStart).count());
+                totalDetections += static_cast<long long>(scaledDetections.size());
+                totalTracks += static_cast<long long>(tracks.size());
+            }
+
+            double passMs = millisecondsSince(passStart);
+            replayMs += passMs;
+            std::cout << "Pass " << pass + 1 << "/" << passes << ": " << frames.size() * 1000.0 / passMs << " FPS" << std::endl;
+        }
+
+        // ==================== 输出JSON ====================
+        FILE* out = std::fopen(outputPath.c_str(), "w");
+        if (!out) {
+            std::cerr << "Cannot create output file: " << outputPath << std::endl;
+            return -1;
+        }
+
+        std::fprintf(out, "{\n");
+        std::fprintf(out, "  \"video\": \"%s\",\n", jsonEscape(config.getVideoPath()).c_str());
+        std::fprintf(out, "  \"device\": \"%s\",\n", config.getDevice().c_str());
+        std::fprintf(out, "  \"precision\": \"%s\",\n", config.getInferencePrecision().c_str());
+        std::fprintf(out, "  \"model_preprocess\": %s,\n", config.getUseModelPreprocess() ? "true" : "false");
+        std::fprintf(out, "  \"nms_mode\": \"%s\",\n", config.getNMSMode().c_str());
+        std::fprintf(out, "  \"frame_width\": %d,\n", frames.front().cols);
+        std::fprintf(out, "  \"frame_height\": %d,\n", frames.front().rows);
+        std::fprintf(out, "  \"frames\": %zu,\n", frames.size());
+        std::fprintf(out, "  \"passes\": %d,\n", passes);
+        std::fprintf(out, "  \"decoded_mb\": %.1f,\n", frameBytes / (1024.0 * 1024.0));
+        std::fprintf(out, "  \"decode_ms\": %.1f,\n", decodeMs);
+        std::fprintf(out, "  \"replay_ms\": %.1f,\n", replayMs);
+        std::fprintf(out, "  \"throughput_fps\": %.2f,\n", replayMs > 0.0 ? sampleCount * 1000.0 / replayMs : 0.0);
+        std::fprintf(out, "  \"detections_per_frame\": %.3f,\n", static_cast<double>(totalDetections) / sampleCount);
+        std::fprintf(out, "  \"tracks_per_frame\": %.3f,\n", static_cast<double>(totalTracks) / sampleCount);
+        std::fprintf(out, "  \"stages\": {\n");
+        writeStageJson(out, preprocessStage, false);
+        writeStageJson(out, inferStage, false);
+        writeStageJson(out, postprocessStage, false);
+        writeStageJson(out, nmsStage, false);
+        writeStageJson(out, scaleStage, false);
+        writeStageJson(out, trackStage, false);
+        writeStageJson(out, totalStage, true);
+        std::fprintf(out, "  }\n");
+        std::fprintf(out, "}\n");
+
+        std::fclose(out);
+        std::cout << "Results written to " << outputPath << std::endl;
+        
+        // 逐层耗时：回放排除了解码干扰，适合对比重新训练的模型在目标CPU上的热点层
+        if (detector.isProfilingEnabled()) {
+            PerformanceMonitor performanceMonitor;
+            performanceMonitor.printLayerProfiles(detector.getLayerProfiles(), config.getProfilingTopN());
+            if (!config.getProfilingCsvPath().empty() &&
+                performanceMonitor.writeLayerProfilesCsv(detector.getLayerProfiles(), config.getProfilingCsvPath())) {
+                std::cout << "Layer profile written to " << config.getProfilingCsvPath() << std::endl;
+            }
+        }
+
+        return 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Program execution error: " << e.what() << std::endl;
+        return -1;
+    }
+}
@@ -0,0 +1,359 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "../ncnn/cpp/include/BYTETracker.h"
+#include "../ncnn/cpp/include/lapjv.h"
+
+// 跟踪器微基准测试（Google Benchmark）：
+//   1. 卡尔曼滤波的predict/project/update
+//   2. IoU代价矩阵（ious、iou_distance）和lapjv匹配（含lapjv_internal）
+//   3. 轨迹集合运算joint_stracks/sub_stracks
+//   4. 完整的BYTETracker::update
+// 各项按轨迹数和检测数（1到1000）参数化，使用合成的网格目标，不需要模型和视频
+//
+// 用法：tracker_benchmark [Google Benchmark参数]
+//   如 --benchmark_filter=Lapjv 只运行匹配相关项，--benchmark_format=json 输出JSON便于对比
+
+// 访问BYTETracker内部的匹配和轨迹集合函数
+struct BYTETrackerBenchmarkAccess {
+    static vector<vector<float> > ious(BYTETracker& tracker, vector<vector<float> >& atlbrs,
+                                       vector<vector<float> >& btlbrs) {
+        return tracker.ious(atlbrs, btlbrs);
+    }
+
+    static vector<vector<float> > iouDistance(BYTETracker& tracker, vector<STrack*>& atracks,
+                                              vector<STrack>& btracks, int& distSize, int& distSizeSize) {
+        return tracker.iou_distance(atracks, btracks, distSize, distSizeSize);
+    }
+
+    static double lapjv(BYTETracker& tracker, const vector<vector<float> >& cost,
+                        vector<int>& rowsol, vector<int>& colsol, float costLimit) {
+        return tracker.lapjv(cost, rowsol, colsol, true, costLimit);
+    }
+
+    static vector<STrack*> jointStracks(BYTETracker& tracker, vector<STrack*>& tlista, vector<STrack>& tlistb) {
+        return tracker.joint_stracks(tlista, tlistb);
+    }
+
+    static vector<STrack> jointStracks(BYTETracker& tracker, vector<STrack>& tlista, vector<STrack>& tlistb) {
+        return tracker.joint_stracks(tlista, tlistb);
+    }
+
+    static vector<STrack> subStracks(BYTETracker& tracker, vector<STrack>& tlista, vector<STrack>& tlistb) {
+        return tracker.sub_stracks(tlista, tlistb);
+    }
+};
+
+namespace {
+
+constexpr int kGridColumns = 32;            // 目标按网格排列，每行32个
+constexpr float kGridSpacing = 40.0f;       // 网格间距（像素）
+constexpr float kBoxSize = 24.0f;           // 目标边长，相邻目标互不重叠
+constexpr float kJitter = 2.0f;             // 每帧位置抖动（像素）
+constexpr float kMatchThresh = 0.8f;        // 与BYTETracker一致的匹配阈值
+constexpr int kSceneFrames = 64;            // update基准循环使用的帧数
+
+// 第index个目标的tlwh框：网格位置加随机抖动，同一index的轨迹和检测互相重叠
+vector<float> makeTlwh(int index, std::mt19937& rng) {
+    std::uniform_real_distribution<float> jitter(-kJitter, kJitter);
+    float x = (index % kGridColumns) * kGridSpacing + jitter(rng);
+    float y = (index / kGridColumns) * kGridSpacing + jitter(rng);
+    return {x, y, kBoxSize, kBoxSize};
+}
+
+// 未激活的检测框
+vector<STrack> makeDetections(int count, unsigned seed) {
+    std::mt19937 rng(seed);
+    vector<STrack> detections;
+    detections.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        detections.emplace_back(makeTlwh(i, rng), 0.9f);
+    }
+    return detections;
+}
+
+// 已激活的轨迹（带卡尔曼状态和唯一ID）
+vector<STrack> makeTracks(int count, unsigned seed, byte_kalman::KalmanFilter& kalmanFilter) {
+    vector<STrack> tracks = makeDetections(count, seed);
+    for (auto& track : tracks) {
+        track.activate(kalmanFilter, 1);
+    }
+    return tracks;
+}
+
+vector<STrack*> pointersTo(vector<STrack>& tracks) {
+    vector<STrack*> pointers;
+    for (auto& track : tracks) {
+        pointers.push_back(&track);
+    }
+    return pointers;
+}
+
+// 与tracks各自独立的第二个轨迹列表，前一半（按两者较短者计）与tracks共用ID
+vector<STrack> makeOverlappingTracks(vector<STrack>& tracks, int count, byte_kalman::KalmanFilter& kalmanFilter) {
+    vector<STrack> other = makeTracks(count, 2, kalmanFilter);
+    size_t shared = std::min(tracks.size(), other.size()) / 2;
+    for (size_t i = 0; i < shared; ++i) {
+        other[i].track_id = tracks[i].track_id;
+    }
+    return other;
+}
+
+// 卡尔曼状态：每条轨迹一组均值、协方差和观测
+struct KalmanStates {
+    vector<KAL_MEAN> means;
+    vector<KAL_COVA> covariances;
+    vector<DETECTBOX> measurements;
+};
+
+KalmanStates makeKalmanStates(int count, byte_kalman::KalmanFilter& kalmanFilter) {
+    KalmanStates states;
+    std::mt19937 rng(1);
+    for (int i = 0; i < count; ++i) {
+        vector<float> tlwh = makeTlwh(i, rng);
+        DETECTBOX xyah;
+        xyah << tlwh[0] + tlwh[2] / 2, tlwh[1] + tlwh[3] / 2, tlwh[2] / tlwh[3], tlwh[3];
+        KAL_DATA data = kalmanFilter.initiate(xyah);
+        states.means.push_back(data.first);
+        states.covariances.push_back(data.second);
+        xyah(0) += 1.0f;
+        states.measurements.push_back(xyah);
+    }
+    return states;
+}
+
+// ==================== 卡尔曼滤波 ====================
+
+void BM_KalmanPredict(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    byte_kalman::KalmanFilter kalmanFilter;
+    KalmanStates states = makeKalmanStates(count, kalmanFilter);
+    for (auto _ : state) {
+        for (int i = 0; i < count; ++i) {
+            // 每次从相同的初始状态预测，避免协方差随迭代次数无限增长
+            KAL_MEAN mean = states.means[i];
+            KAL_COVA covariance = states.covariances[i];
+            kalmanFilter.predict(mean, covariance);
+            benchmark::DoNotOptimize(mean.data());
+            benchmark::DoNotOptimize(covariance.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+void BM_KalmanProject(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    byte_kalman::KalmanFilter kalmanFilter;
+    KalmanStates states = makeKalmanStates(count, kalmanFilter);
+    for (auto _ : state) {
+        for (int i = 0; i < count; ++i) {
+            KAL_HDATA projected = kalmanFilter.project(states.means[i], states.covariances[i]);
+            benchmark::DoNotOptimize(projected.first.data());
+            benchmark::DoNotOptimize(projected.second.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+void BM_KalmanUpdate(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    byte_kalman::KalmanFilter kalmanFilter;
+    KalmanStates states = makeKalmanStates(count, kalmanFilter);
+    for (auto _ : state) {
+        for (int i = 0; i < count; ++i) {
+            KAL_DATA updated = kalmanFilter.update(states.means[i], states.covariances[i], states.measurements[i]);
+            benchmark::DoNotOptimize(updated.first.data());
+            benchmark::DoNotOptimize(updated.second.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+// ==================== IoU代价与匹配 ====================
+
+void BM_Ious(benchmark::State& state) {
+    byte_kalman::KalmanFilter kalmanFilter;
+    BYTETracker tracker(30, 30);
+    vector<STrack> tracks = makeTracks(static_cast<int>(state.range(0)), 1, kalmanFilter);
+    vector<STrack> detections = makeDetections(static_cast<int>(state.range(1)), 2);
+    vector<vector<float> > atlbrs, btlbrs;
+    for (const auto& track : tracks) atlbrs.push_back(track.tlbr);
+    for (const auto& detection : detections) btlbrs.push_back(detection.tlbr);
+
+    for (auto _ : state) {
+        vector<vector<float> > ious = BYTETrackerBenchmarkAccess::ious(tracker, atlbrs, btlbrs);
+        benchmark::DoNotOptimize(ious.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(1));
+}
+
+void BM_IouDistance(benchmark::State& state) {
+    byte_kalman::KalmanFilter kalmanFilter;
+    BYTETracker tracker(30, 30);
+    vector<STrack> tracks = makeTracks(static_cast<int>(state.range(0)), 1, kalmanFilter);
+    vector<STrack> detections = makeDetections(static_cast<int>(state.range(1)), 2);
+    vector<STrack*> trackPointers = pointersTo(tracks);
+
+    for (auto _ : state) {
+        int distSize = 0, distSizeSize = 0;
+        vector<vector<float> > cost = BYTETrackerBenchmarkAccess::iouDistance(
+            tracker, trackPointers, detections, distSize, distSizeSize);
+        benchmark::DoNotOptimize(cost.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(1));
+}
+
+// BYTETracker::lapjv：扩展为(轨迹数+检测数)方阵后调用lapjv_internal，与linear_assignment的调用方式一致
+void BM_Lapjv(benchmark::State& state) {
+    byte_kalman::KalmanFilter kalmanFilter;
+    BYTETracker tracker(30, 30);
+    vector<STrack> tracks = makeTracks(static_cast<int>(state.range(0)), 1, kalmanFilter);
+    vector<STrack> detections = makeDetections(static_cast<int>(state.range(1)), 2);
+    vector<STrack*> trackPointers = pointersTo(tracks);
+    int distSize = 0, distSizeSize = 0;
+    vector<vector<float> > cost = BYTETrackerBenchmarkAccess::iouDistance(
+        tracker, trackPointers, detections, distSize, distSizeSize);
+
+    for (auto _ : state) {
+        vector<int> rowsol, colsol;
+        double totalCost = BYTETrackerBenchmarkAccess::lapjv(tracker, cost, rowsol, colsol, kMatchThresh);
+        benchmark::DoNotOptimize(totalCost);
+    }
+}
+
+// lapjv_internal：n×n方阵，代价为n条轨迹与n个检测的IoU距离
+void BM_LapjvInternal(benchmark::State& state) {
+    const int n = static_cast<int>(state.range(0));
+    byte_kalman::KalmanFilter kalmanFilter;
+    BYTETracker tracker(30, 30);
+    vector<STrack> tracks = makeTracks(n, 1, kalmanFilter);
+    vector<STrack> detections = makeDetections(n, 2);
+    vector<STrack*> trackPointers = pointersTo(tracks);
+    int distSize = 0, distSizeSize = 0;
+    vector<vector<float> > cost = BYTETrackerBenchmarkAccess::iouDistance(
+        tracker, trackPointers, detections, distSize, distSizeSize);
+
+    vector<vector<double> > costRows(n, vector<double>(n));
+    vector<double*> costPointers(n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            costRows[i][j] = cost[i][j];
+        }
+        costPointers[i] = costRows[i].data();
+    }
+    vector<int_t> x(n), y(n);
+
+    for (auto _ : state) {
+        int_t ret = lapjv_internal(static_cast<uint_t>(n), costPointers.data(), x.data(), y.data());
+        benchmark::DoNotOptimize(ret);
+        benchmark::DoNotOptimize(x.data());
+    }
+}
+
+// ==================== 轨迹集合运算 ====================
+
+void BM_JointStracks(benchmark::State& state) {
+    byte_kalman::KalmanFilter kalmanFilter;
+    BYTETracker tracker(30, 30);
+    vector<STrack> tlista = makeTracks(static_cast<int>(state.range(0)), 1, kalmanFilter);
+    vector<STrack> tlistb = makeOverlappingTracks(tlista, static_cast<int>(state.range(1)), kalmanFilter);
+
+    for (auto _ : state) {
+        vector<STrack> joined = BYTETrackerBenchmarkAccess::jointStracks(tracker, tlista, tlistb);
+        benchmark::DoNotOptimize(joined.data());
+    }
+    state.SetItemsProcessed(state.iterations() * (state.range(0) + state.range(1)));
+}
+
+// 指针版本：update中由已确认轨迹和丢失轨迹组成strack_pool
+void BM_JointStracksPointer(benchmark::State& state) {
+    byte_kalman::KalmanFilter kalmanFilter;
+    BYTETracker tracker(30, 30);
+    vector<STrack> tlista = makeTracks(static_cast<int>(state.range(0)), 1, kalmanFilter);
+    vector<STrack> tlistb = makeOverlappingTracks(tlista, static_cast<int>(state.range(1)), kalmanFilter);
+    vector<STrack*> tlistaPointers = pointersTo(tlista);
+
+    for (auto _ : state) {
+        vector<STrack*> joined = BYTETrackerBenchmarkAccess::jointStracks(tracker, tlistaPointers, tlistb);
+        benchmark::DoNotOptimize(joined.data());
+    }
+    state.SetItemsProcessed(state.iterations() * (state.range(0) + state.range(1)));
+}
+
+void BM_SubStracks(benchmark::State& state) {
+    byte_kalman::KalmanFilter kalmanFilter;
+    BYTETracker tracker(30, 30);
+    vector<STrack> tlista = makeTracks(static_cast<int>(state.range(0)), 1, kalmanFilter);
+    vector<STrack> tlistb = makeOverlappingTracks(tlista, static_cast<int>(state.range(1)), kalmanFilter);
+
+    for (auto _ : state) {
+        vector<STrack> remaining = BYTETrackerBenchmarkAccess::subStracks(tracker, tlista, tlistb);
+        benchmark::DoNotOptimize(remaining.data());
+    }
+    state.SetItemsProcessed(state.iterations() * (state.range(0) + state.range(1)));
+}
+
+// ==================== 完整update ====================
+
+// 稳态跟踪：目标在网格上小幅抖动，轨迹数等于高分检测数；
+// 第二个参数为低分检测（进入第二次关联）的百分比
+void BM_TrackerUpdate(benchmark::State& state) {
+    const int count = static_cast<int>(state.range(0));
+    const int lowScorePercent = static_cast<int>(state.range(1));
+    std::mt19937 rng(3);
+
+    vector<vector<Object> > frames(kSceneFrames);
+    for (auto& objects : frames) {
+        for (int i = 0; i < count; ++i) {
+            vector<float> tlwh = makeTlwh(i, rng);
+            Object object;
+            object.rect = cv::Rect_<float>(tlwh[0], tlwh[1], tlwh[2], tlwh[3]);
+            object.label = 0;
+            object.prob = (i * 100 / count) < lowScorePercent ? 0.3f : 0.9f;
+            objects.push_back(object);
+        }
+    }
+
+    // 先运行一遍场景，使轨迹进入已确认状态
+    BYTETracker tracker(30, 30);
+    for (const auto& objects : frames) {
+        tracker.update(objects);
+    }
+
+    size_t frameIndex = 0;
+    for (auto _ : state) {
+        vector<STrack> output = tracker.update(frames[frameIndex]);
+        benchmark::DoNotOptimize(output.data());
+        frameIndex = (frameIndex + 1) % frames.size();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+} // namespace
+
+// 数量参数：1、10、100、1000
+BENCHMARK(BM_KalmanPredict)->ArgName("tracks")->RangeMultiplier(10)->Range(1, 1000);
+BENCHMARK(BM_KalmanProject)->ArgName("tracks")->RangeMultiplier(10)->Range(1, 1000);
+BENCHMARK(BM_KalmanUpdate)->ArgName("tracks")->RangeMultiplier(10)->Range(1, 1000);
+
+BENCHMARK(BM_Ious)->ArgNames({"tracks", "detections"})->RangeMultiplier(10)->Ranges({{1, 1000}, {1, 1000}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_IouDistance)->ArgNames({"tracks", "detections"})->RangeMultiplier(10)->Ranges({{1, 1000}, {1, 1000}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Lapjv)->ArgNames({"tracks", "detections"})->RangeMultiplier(10)->Ranges({{1, 1000}, {1, 1000}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_LapjvInternal)->ArgName("n")->RangeMultiplier(10)->Range(1, 1000)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_JointStracks)->ArgNames({"tracks", "detections"})->RangeMultiplier(10)->Ranges({{1, 1000}, {1, 1000}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_JointStracksPointer)->ArgNames({"tracks", "detections"})->RangeMultiplier(10)
+    ->Ranges({{1, 1000}, {1, 1000}})->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SubStracks)->ArgNames({"tracks", "detections"})->RangeMultiplier(10)->Ranges({{1, 1000}, {1, 1000}})
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_TrackerUpdate)->ArgNames({"objects", "low_score_percent"})
+    ->ArgsProduct({{1, 10, 100, 1000}, {0, 50}})->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();